@@ -41,22 +41,28 @@ TEMPLATE = app
 
 SOURCES += main.cpp\
         mainwindow.cpp \
-    collapsible.cpp \
     mainctrl.cpp \
     nodectrl.cpp \
-    nodeproperties.cpp \
+    nodepropertymodel.cpp \
     propertyeditor.cpp \
     zodiacgraph/baseedge.cpp \
     zodiacgraph/bezieredge.cpp \
+    zodiacgraph/cachepolicy.cpp \
+    zodiacgraph/cubicbezier.cpp \
+    zodiacgraph/draglayer.cpp \
     zodiacgraph/drawedge.cpp \
     zodiacgraph/edgearrow.cpp \
+    zodiacgraph/edgegeometrybuffer.cpp \
     zodiacgraph/edgegroup.cpp \
     zodiacgraph/edgegroupinterface.cpp \
     zodiacgraph/edgegrouppair.cpp \
+    zodiacgraph/edgeindex.cpp \
     zodiacgraph/edgelabel.cpp \
     zodiacgraph/labeltextfactory.cpp \
+    zodiacgraph/mutationqueue.cpp \
     zodiacgraph/node.cpp \
     zodiacgraph/nodehandle.cpp \
+    zodiacgraph/nodeindex.cpp \
     zodiacgraph/nodelabel.cpp \
     zodiacgraph/perimeter.cpp \
     zodiacgraph/plug.cpp \
@@ -66,27 +72,36 @@ SOURCES += main.cpp\
     zodiacgraph/pluglabel.cpp \
     zodiacgraph/scene.cpp \
     zodiacgraph/scenehandle.cpp \
+    zodiacgraph/signalhub.cpp \
+    zodiacgraph/spriteatlas.cpp \
     zodiacgraph/straightdoubleedge.cpp \
     zodiacgraph/straightedge.cpp \
+    zodiacgraph/textlayoutcache.cpp \
     zodiacgraph/view.cpp
 
 HEADERS  += mainwindow.h \
-    collapsible.h \
     mainctrl.h \
     nodectrl.h \
-    nodeproperties.h \
+    nodepropertymodel.h \
     propertyeditor.h \
     zodiacgraph/baseedge.h \
     zodiacgraph/bezieredge.h \
+    zodiacgraph/cachepolicy.h \
+    zodiacgraph/cubicbezier.h \
+    zodiacgraph/draglayer.h \
     zodiacgraph/drawedge.h \
     zodiacgraph/edgearrow.h \
+    zodiacgraph/edgegeometrybuffer.h \
     zodiacgraph/edgegroup.h \
     zodiacgraph/edgegroupinterface.h \
     zodiacgraph/edgegrouppair.h \
+    zodiacgraph/edgeindex.h \
     zodiacgraph/edgelabel.h \
     zodiacgraph/labeltextfactory.h \
+    zodiacgraph/mutationqueue.h \
     zodiacgraph/node.h \
     zodiacgraph/nodehandle.h \
+    zodiacgraph/nodeindex.h \
     zodiacgraph/nodelabel.h \
     zodiacgraph/perimeter.h \
     zodiacgraph/plug.h \
@@ -96,8 +111,11 @@ HEADERS  += mainwindow.h \
     zodiacgraph/pluglabel.h \
     zodiacgraph/scene.h \
     zodiacgraph/scenehandle.h \
+    zodiacgraph/signalhub.h \
+    zodiacgraph/spriteatlas.h \
     zodiacgraph/straightdoubleedge.h \
     zodiacgraph/straightedge.h \
+    zodiacgraph/textlayoutcache.h \
     zodiacgraph/utils.h \
     zodiacgraph/view.h
 
@@ -6,6 +6,7 @@
 #include "nodectrl.h"
 #include "propertyeditor.h"
 #include "zodiacgraph/nodehandle.h"
+#include "zodiacgraph/signalhub.h"
 
 QString MainCtrl::s_defaultName = "Node ";
 
@@ -18,8 +19,19 @@ MainCtrl::MainCtrl(QObject *parent, zodiac::Scene* scene, PropertyEditor* proper
 {
     m_propertyEditor->setMainCtrl(this);
 
-    connect(&m_scene, SIGNAL(selectionChanged(QList<zodiac::NodeHandle>)),
-            this, SLOT(selectionChanged(QList<zodiac::NodeHandle>)));
+    connect(&m_scene, SIGNAL(selectionChanged(QList<zodiac::NodeHandle>, QList<zodiac::NodeHandle>)),
+            this, SLOT(selectionChanged(QList<zodiac::NodeHandle>, QList<zodiac::NodeHandle>)));
+
+    // all node notifications arrive through the hub and are passed on to the respective node controller
+    zodiac::SignalHub* signalHub = m_scene.getSignalHub();
+    connect(signalHub, SIGNAL(nodeRemovalRequested(zodiac::NodeHandle)),
+            this, SLOT(nodeRemovalRequested(zodiac::NodeHandle)));
+    connect(signalHub, SIGNAL(plugsConnected(zodiac::PlugHandle, zodiac::PlugHandle)),
+            this, SLOT(plugsConnected(zodiac::PlugHandle, zodiac::PlugHandle)));
+    connect(signalHub, SIGNAL(plugsDisconnected(zodiac::PlugHandle, zodiac::PlugHandle)),
+            this, SLOT(plugsDisconnected(zodiac::PlugHandle, zodiac::PlugHandle)));
+    connect(signalHub, SIGNAL(plugsDisconnectedInBulk(QList<QPair<zodiac::PlugHandle, zodiac::PlugHandle>>)),
+            this, SLOT(plugsDisconnectedInBulk(QList<QPair<zodiac::PlugHandle, zodiac::PlugHandle>>)));
 }
 
 NodeCtrl* MainCtrl::createNode(const QString& name)
@@ -64,6 +76,27 @@ bool MainCtrl::deleteNode(NodeCtrl* node)
     return result;
 }
 
+int MainCtrl::deleteNodes(const QList<NodeCtrl*>& nodes)
+{
+    // disconnect the nodes and remove them all at once, together with their connections
+    QList<zodiac::NodeHandle> handles;
+    handles.reserve(nodes.size());
+    for(NodeCtrl* node : nodes){
+#ifdef QT_DEBUG
+        Q_ASSERT(m_nodes.contains(node->getNodeHandle()));
+#else
+        if(!m_nodes.contains(node->getNodeHandle())){
+            continue;
+        }
+#endif
+        node->disconnect();
+        zodiac::NodeHandle handle = node->getNodeHandle();
+        m_nodes.remove(handle);
+        handles.append(handle);
+    }
+    return m_scene.removeNodes(handles);
+}
+
 void MainCtrl::printZodiacScene()
 {
     QList<zodiac::NodeHandle> allNodes = m_nodes.keys();
@@ -102,8 +135,14 @@ void MainCtrl::printZodiacScene()
 
 bool MainCtrl::shutdown()
 {
-    // do not receive any more signals from the scene handle
+    // do not receive any more signals from the scene handle or its hub
     m_scene.disconnect();
+    m_scene.getSignalHub()->disconnect(this);
+
+    // tear down the graph at once instead of leaving each node to be removed separately
+    m_propertyEditor->showNodes(QList<zodiac::NodeHandle>());
+    m_nodes.clear();
+    m_scene.clear();
 
     return true;
 }
@@ -125,7 +164,60 @@ void MainCtrl::createDefaultNode()
     newNode->setSelected(true);
 }
 
-void MainCtrl::selectionChanged(QList<zodiac::NodeHandle> selection)
+void MainCtrl::selectionChanged(QList<zodiac::NodeHandle> selected, QList<zodiac::NodeHandle> deselected)
+{
+    m_propertyEditor->updateNodes(selected, deselected);
+}
+
+void MainCtrl::nodeRemovalRequested(zodiac::NodeHandle node)
+{
+    NodeCtrl* nodeCtrl = getCtrlForHandle(node);
+    if(nodeCtrl){
+        nodeCtrl->remove();
+    }
+}
+
+void MainCtrl::plugsConnected(zodiac::PlugHandle output, zodiac::PlugHandle input)
+{
+    NodeCtrl* outputCtrl = getCtrlForHandle(output.getNode());
+    if(outputCtrl){
+        outputCtrl->outputConnected(output, input);
+    }
+    NodeCtrl* inputCtrl = getCtrlForHandle(input.getNode());
+    if(inputCtrl){
+        inputCtrl->inputConnected(input, output);
+    }
+}
+
+void MainCtrl::plugsDisconnected(zodiac::PlugHandle output, zodiac::PlugHandle input)
 {
-    m_propertyEditor->showNodes(selection);
+    // one of the nodes may have been removed together with the connection
+    NodeCtrl* outputCtrl = getCtrlForHandle(output.getNode());
+    if(outputCtrl){
+        outputCtrl->outputDisconnected(output, input);
+    }
+    NodeCtrl* inputCtrl = getCtrlForHandle(input.getNode());
+    if(inputCtrl){
+        inputCtrl->inputDisconnected(input, output);
+    }
+}
+
+void MainCtrl::plugsDisconnectedInBulk(QList<QPair<zodiac::PlugHandle, zodiac::PlugHandle>> connections)
+{
+    // sort the connections by the remaining node controllers, so each of them is only updated once
+    QHash<NodeCtrl*, QList<QPair<zodiac::PlugHandle, zodiac::PlugHandle>>> lostConnections;
+    for(const QPair<zodiac::PlugHandle, zodiac::PlugHandle>& connection : connections){
+        NodeCtrl* outputCtrl = getCtrlForHandle(connection.first.getNode());
+        if(outputCtrl){
+            lostConnections[outputCtrl].append(connection);
+        }
+        NodeCtrl* inputCtrl = getCtrlForHandle(connection.second.getNode());
+        if(inputCtrl){
+            lostConnections[inputCtrl].append(qMakePair(connection.second, connection.first));
+        }
+    }
+    for(QHash<NodeCtrl*, QList<QPair<zodiac::PlugHandle, zodiac::PlugHandle>>>::const_iterator it
+            = lostConnections.constBegin(); it!=lostConnections.constEnd(); ++it){
+        it.key()->plugsDisconnected(it.value());
+    }
 }
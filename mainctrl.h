@@ -76,6 +76,15 @@ public: // methods
     ///
     bool deleteNode(NodeCtrl* node);
 
+    ///
+    /// \brief Deletes multiple nodes from the graph at once, including all of their connections.
+    ///
+    /// \param [in] nodes   Nodes to delete.
+    ///
+    /// \return             Number of deleted nodes.
+    ///
+    int deleteNodes(const QList<NodeCtrl*>& nodes);
+
     ///
     /// \brief Returns the NodeCtrl that manages a given NodeHandle.
     ///
@@ -114,9 +123,40 @@ private slots:
     ///
     /// \brief Called when the selection in the managed scene has changed.
     ///
-    /// \param [in] selection   Handles to all selected nodes.
+    /// \param [in] selected    Handles to all nodes that were added to the selection.
+    /// \param [in] deselected  Handles to all nodes that were removed from the selection.
+    ///
+    void selectionChanged(QList<zodiac::NodeHandle> selected, QList<zodiac::NodeHandle> deselected);
+
+    ///
+    /// \brief Called when the user requested the removal of a node.
+    ///
+    /// \param [in] node    Handle of the node to remove.
+    ///
+    void nodeRemovalRequested(zodiac::NodeHandle node);
+
+    ///
+    /// \brief Called when two plugs in the managed scene were connected.
+    ///
+    /// \param [in] output  Outgoing plug of the connection.
+    /// \param [in] input   Incoming plug of the connection.
+    ///
+    void plugsConnected(zodiac::PlugHandle output, zodiac::PlugHandle input);
+
+    ///
+    /// \brief Called when the connection between two plugs in the managed scene was removed.
+    ///
+    /// \param [in] output  Outgoing plug of the connection.
+    /// \param [in] input   Incoming plug of the connection.
+    ///
+    void plugsDisconnected(zodiac::PlugHandle output, zodiac::PlugHandle input);
+
+    ///
+    /// \brief Called when many connections were removed together with nodes of the managed scene.
+    ///
+    /// \param [in] connections Removed connections as pairs of (output, input).
     ///
-    void selectionChanged(QList<zodiac::NodeHandle> selection);
+    void plugsDisconnectedInBulk(QList<QPair<zodiac::PlugHandle, zodiac::PlugHandle>> connections);
 
 private: // members
 
@@ -1,5 +1,7 @@
 #include "nodectrl.h"
 
+#include <QSet>
+
 #include "mainctrl.h"
 
 typedef zodiac::PlugHandle PlugHandle;
@@ -10,16 +12,6 @@ NodeCtrl::NodeCtrl(MainCtrl* manager,  zodiac::NodeHandle node)
     , m_node(node)
     , m_plugs(QHash<PlugHandle, QList<PlugHandle>>())
 {
-    // connect node signals
-    connect(&m_node, SIGNAL(removalRequested()), this, SLOT(remove()));
-    connect(&m_node, SIGNAL(inputConnected(zodiac::PlugHandle, zodiac::PlugHandle)),
-            this, SLOT(inputConnected(zodiac::PlugHandle, zodiac::PlugHandle)));
-    connect(&m_node, SIGNAL(outputConnected(zodiac::PlugHandle, zodiac::PlugHandle)),
-            this, SLOT(outputConnected(zodiac::PlugHandle, zodiac::PlugHandle)));
-    connect(&m_node, SIGNAL(inputDisconnected(zodiac::PlugHandle, zodiac::PlugHandle)),
-            this, SLOT(inputDisconnected(zodiac::PlugHandle, zodiac::PlugHandle)));
-    connect(&m_node, SIGNAL(outputDisconnected(zodiac::PlugHandle, zodiac::PlugHandle)),
-            this, SLOT(outputDisconnected(zodiac::PlugHandle, zodiac::PlugHandle)));
 }
 
 void NodeCtrl::rename(const QString& name)
@@ -142,3 +134,24 @@ void NodeCtrl::outputDisconnected(PlugHandle myOutput, PlugHandle otherInput)
     m_plugs[myOutput].removeOne(otherInput);
     Q_ASSERT(m_plugs[myOutput].count(otherInput) == 0);
 }
+
+void NodeCtrl::plugsDisconnected(const QList<QPair<PlugHandle, PlugHandle>>& connections)
+{
+    // collect the lost connections of each plug first, so its list of connected plugs is only filtered once
+    QHash<PlugHandle, QSet<PlugHandle>> lostPlugs;
+    for(const QPair<PlugHandle, PlugHandle>& connection : connections){
+        lostPlugs[connection.first].insert(connection.second);
+    }
+    for(QHash<PlugHandle, QSet<PlugHandle>>::const_iterator it = lostPlugs.constBegin();
+        it!=lostPlugs.constEnd(); ++it){
+        QList<PlugHandle>& otherPlugs = m_plugs[it.key()];
+        QList<PlugHandle> remainingPlugs;
+        remainingPlugs.reserve(otherPlugs.size());
+        for(const PlugHandle& otherPlug : otherPlugs){
+            if(!it.value().contains(otherPlug)){
+                remainingPlugs.append(otherPlug);
+            }
+        }
+        otherPlugs = remainingPlugs;
+    }
+}
@@ -145,62 +145,67 @@ public: // methods
     ///
     void setSelected(bool isSelected);
 
-public slots:
-
     ///
-    /// \brief Tries to remove this logical node from the graph.
+    /// \brief Is called by the MainCtrl, when an incoming plug of the managed Node has been connected to an outgoing
+    /// plug of another Node.
     ///
-    /// \return <i>true</i> if the node was removed -- <i>false</i> otherwise.
+    /// \param [in] myInput     The input plug of the managed Node.
+    /// \param [in] otherOutput The output plug of the source Node.
     ///
-    bool remove();
-
-private: // methods
+    void inputConnected(zodiac::PlugHandle myInput, zodiac::PlugHandle otherOutput);
 
     ///
-    /// \brief Creates a new incoming Plug for the managed Node.
+    /// \brief Is called by the MainCtrl, when an outgoing plug of the managed Node has been connected to an incoming
+    /// plug of another Node.
     ///
-    /// \param [in] name        The proposed name of the plug.
-    /// \param [in] incoming    <i>true</i> if the created Plug could be incoming -- <i>false</i> to be ougoing.
-    ///
-    /// \return                 Handle of the created Plug.
+    /// \param [in] myOutput    The output plug of the managed Node.
+    /// \param [in] otherInput  The input plug of the target Node.
     ///
-    zodiac::PlugHandle addPlug(const QString& name, bool incoming);
+    void outputConnected(zodiac::PlugHandle myOutput, zodiac::PlugHandle otherInput);
 
-private slots:
+    ///
+    /// \brief Is called by the MainCtrl, when a connection from an incoming plug of the managed Node was removed.
+    ///
+    /// \param [in] myInput     The input plug of the managed Node.
+    /// \param [in] otherOutput The output plug of the source Node.
+    ///
+    void inputDisconnected(zodiac::PlugHandle myInput, zodiac::PlugHandle otherOutput);
 
     ///
-    /// \brief Is emitted, when an incoming plug of the managed Node has been connected to an outgoing plug of another
-    /// Node.
+    /// \brief Is called by the MainCtrl, when a connection from an outgoing plug of the managed Node was removed.
     ///
-    /// \param [out] myInput        The input plug of the managed Node.
-    /// \param [out] otherOutput    The output plug of the source Node.
+    /// \param [in] myOutput    The output plug of the managed Node.
+    /// \param [in] otherInput  The input plug of the target Node.
     ///
-    void inputConnected(zodiac::PlugHandle myInput, zodiac::PlugHandle otherOutput);
+    void outputDisconnected(zodiac::PlugHandle myOutput, zodiac::PlugHandle otherInput);
 
     ///
-    /// \brief Is emitted, when an outgoing plug of the managed Node has been connected to an incoming plug of another
-    /// Node.
+    /// \brief Is called by the MainCtrl, when many connections of the managed Node were removed at once.
     ///
-    /// \param [out] myOutput   The output plug of the managed Node.
-    /// \param [out] otherInput The input plug of the target Node.
+    /// \param [in] connections Removed connections as pairs of (plug of the managed Node, plug of the other Node).
     ///
-    void outputConnected(zodiac::PlugHandle myOutput, zodiac::PlugHandle otherInput);
+    void plugsDisconnected(const QList<QPair<zodiac::PlugHandle, zodiac::PlugHandle>>& connections);
+
+public slots:
 
     ///
-    /// \brief Is emitted, when a connection from an incoming plug of the managed Node was removed.
+    /// \brief Tries to remove this logical node from the graph.
     ///
-    /// \param [out] myInput        The input plug of the managed Node.
-    /// \param [out] otherOutput    The output plug of the source Node.
+    /// \return <i>true</i> if the node was removed -- <i>false</i> otherwise.
     ///
-    void inputDisconnected(zodiac::PlugHandle myInput, zodiac::PlugHandle otherOutput);
+    bool remove();
+
+private: // methods
 
     ///
-    /// \brief Is emitted, when a connection from an outgoing plug of the managed Node was removed.
+    /// \brief Creates a new incoming Plug for the managed Node.
     ///
-    /// \param [out] myOutput   The output plug of the managed Node.
-    /// \param [out] otherInput The input plug of the target Node.
+    /// \param [in] name        The proposed name of the plug.
+    /// \param [in] incoming    <i>true</i> if the created Plug could be incoming -- <i>false</i> to be ougoing.
     ///
-    void outputDisconnected(zodiac::PlugHandle myOutput, zodiac::PlugHandle otherInput);
+    /// \return                 Handle of the created Plug.
+    ///
+    zodiac::PlugHandle addPlug(const QString& name, bool incoming);
 
 private: // members
 
@@ -0,0 +1,397 @@
+#include "nodepropertymodel.h"
+
+#include <algorithm>
+
+#include "mainctrl.h"
+#include "nodectrl.h"
+
+QString NodePropertyModel::s_defaultPlugName = "plug";
+
+NodePropertyModel::NodePropertyModel(QObject* parent)
+    : QAbstractItemModel(parent)
+    , m_mainCtrl(nullptr)
+    , m_items(QList<NodeItem*>())
+    , m_itemForNode(QHash<zodiac::NodeHandle, NodeItem*>())
+    , m_removedRows(QList<int>())
+    , m_pendingRemovalCount(0)
+    , m_incomingIcon(QIcon(":/icons/incoming.svg"))
+    , m_outgoingIcon(QIcon(":/icons/outgoing.svg"))
+    , m_addIcon(QIcon(":/icons/plus.svg"))
+    , m_removeIcon(QIcon(":/icons/minus.svg"))
+{
+}
+
+NodePropertyModel::~NodePropertyModel()
+{
+    deleteItems();
+}
+
+void NodePropertyModel::setNodes(const QList<zodiac::NodeHandle>& nodes)
+{
+    Q_ASSERT(m_mainCtrl);
+
+    beginResetModel();
+    deleteItems();
+    m_items.reserve(nodes.size());
+    for(const zodiac::NodeHandle& node : nodes){
+        NodeCtrl* nodeCtrl = m_mainCtrl->getCtrlForHandle(node);
+        if(!nodeCtrl || m_itemForNode.contains(node)){
+            continue;
+        }
+        NodeItem* item = new NodeItem{nodeCtrl, m_items.size(), QList<zodiac::PlugHandle>(), false, true};
+        m_items.append(item);
+        m_itemForNode.insert(node, item);
+    }
+    endResetModel();
+}
+
+int NodePropertyModel::addNodes(const QList<zodiac::NodeHandle>& nodes)
+{
+    Q_ASSERT(m_mainCtrl);
+
+    // collect the controllers of all nodes that are not yet part of the model
+    QList<NodeCtrl*> newNodes;
+    for(const zodiac::NodeHandle& node : nodes){
+        NodeCtrl* nodeCtrl = m_mainCtrl->getCtrlForHandle(node);
+        if(nodeCtrl && !m_itemForNode.contains(node)){
+            newNodes.append(nodeCtrl);
+        }
+    }
+    if(newNodes.isEmpty()){
+        return 0;
+    }
+
+    // insert all new rows at the top with a single notification
+    beginInsertRows(QModelIndex(), 0, newNodes.size()-1);
+    QList<NodeItem*> newItems;
+    newItems.reserve(newNodes.size());
+    for(NodeCtrl* nodeCtrl : newNodes){
+        NodeItem* item = new NodeItem{nodeCtrl, 0, QList<zodiac::PlugHandle>(), false, true};
+        newItems.append(item);
+        m_itemForNode.insert(nodeCtrl->getNodeHandle(), item);
+    }
+    m_items = newItems + m_items;
+    updateRows();
+    endInsertRows();
+
+    return newNodes.size();
+}
+
+void NodePropertyModel::removeNodes(const QList<zodiac::NodeHandle>& nodes)
+{
+    // collect the rows to remove
+    QList<int> rows;
+    for(const zodiac::NodeHandle& node : nodes){
+        NodeItem* item = m_itemForNode.value(node, nullptr);
+        if(item){
+            rows.append(item->row);
+        }
+    }
+    if(rows.isEmpty()){
+        return;
+    }
+
+    // removing all nodes is cheaper as a reset
+    if(rows.size()==m_items.size()){
+        beginResetModel();
+        deleteItems();
+        endResetModel();
+        return;
+    }
+
+    // remove contiguous ranges of rows, starting with the last one
+    std::sort(rows.begin(), rows.end());
+    m_removedRows = rows;
+    m_pendingRemovalCount = rows.size();
+    int index = rows.size()-1;
+    while(index >= 0){
+        int last = rows[index];
+        int first = last;
+        while((index > 0) && (rows[index-1]==first-1)){
+            --first;
+            --index;
+        }
+        --index;
+
+        beginRemoveRows(QModelIndex(), first, last);
+        for(int row = first; row <= last; ++row){
+            NodeItem* item = m_items.at(row);
+            m_itemForNode.remove(item->node->getNodeHandle());
+            delete item;
+        }
+        m_items.erase(m_items.begin()+first, m_items.begin()+last+1);
+        m_pendingRemovalCount = index+1;
+        endRemoveRows();
+    }
+
+    // renumber the remaining rows only once, views in between are served by getRow()
+    updateRows(rows.first());
+    m_removedRows.clear();
+    m_pendingRemovalCount = 0;
+}
+
+void NodePropertyModel::createPlug(const QModelIndex& nodeIndex)
+{
+#ifdef QT_DEBUG
+    Q_ASSERT(isNodeIndex(nodeIndex));
+#else
+    if(!isNodeIndex(nodeIndex)){
+        return;
+    }
+#endif
+    NodeItem* item = getItem(nodeIndex);
+
+    // duplicate plug names are automatically resolved by the zodiac::Node
+    zodiac::PlugHandle plug;
+    if(item->nextPlugIsIncoming){
+        plug = item->node->addIncomingPlug(s_defaultPlugName);
+    } else {
+        plug = item->node->addOutgoingPlug(s_defaultPlugName);
+    }
+    item->nextPlugIsIncoming = !item->nextPlugIsIncoming;
+
+    // unfetched plugs are collected all at once when the node row is expanded
+    if(!item->hasFetchedPlugs){
+        return;
+    }
+    int row = item->plugs.size();
+    beginInsertRows(createIndex(getRow(item), NAME), row, row);
+    item->plugs.append(plug);
+    endInsertRows();
+}
+
+void NodePropertyModel::togglePlugDirection(const QModelIndex& plugIndex)
+{
+#ifdef QT_DEBUG
+    Q_ASSERT(plugIndex.isValid() && !isNodeIndex(plugIndex));
+#else
+    if(!plugIndex.isValid() || isNodeIndex(plugIndex)){
+        return;
+    }
+#endif
+    NodeItem* item = getItem(plugIndex);
+    if(!item->node->togglePlugDirection(item->plugs.at(plugIndex.row()).getName())){
+        return;
+    }
+    QModelIndex directionIndex = plugIndex.sibling(plugIndex.row(), DIRECTION);
+    emit dataChanged(directionIndex, directionIndex);
+}
+
+void NodePropertyModel::removePlug(const QModelIndex& plugIndex)
+{
+#ifdef QT_DEBUG
+    Q_ASSERT(plugIndex.isValid() && !isNodeIndex(plugIndex));
+#else
+    if(!plugIndex.isValid() || isNodeIndex(plugIndex)){
+        return;
+    }
+#endif
+    NodeItem* item = getItem(plugIndex);
+    int row = plugIndex.row();
+    zodiac::PlugHandle plug = item->plugs.at(row);
+
+    // do nothing, if the plug cannot be removed
+    if(!plug.isRemovable()){
+        return;
+    }
+
+    // remove the row first, then the plug from the logical node
+    QString plugName = plug.getName();
+    beginRemoveRows(plugIndex.parent(), row, row);
+    item->plugs.removeAt(row);
+    endRemoveRows();
+    item->node->removePlug(plugName);
+}
+
+QModelIndex NodePropertyModel::index(int row, int column, const QModelIndex& parent) const
+{
+    if((row < 0) || (column < 0) || (column >= COLUMN_COUNT)){
+        return QModelIndex();
+    }
+    if(!parent.isValid()){
+        if(row >= m_items.size()){
+            return QModelIndex();
+        }
+        return createIndex(row, column);
+    }
+    if(!isNodeIndex(parent)){
+        return QModelIndex();
+    }
+    NodeItem* item = m_items.value(parent.row(), nullptr);
+    if(!item || (row >= item->plugs.size())){
+        return QModelIndex();
+    }
+    return createIndex(row, column, item);
+}
+
+QModelIndex NodePropertyModel::parent(const QModelIndex& child) const
+{
+    if(!child.isValid() || isNodeIndex(child)){
+        return QModelIndex();
+    }
+    return createIndex(getRow(static_cast<NodeItem*>(child.internalPointer())), NAME);
+}
+
+int NodePropertyModel::rowCount(const QModelIndex& parent) const
+{
+    if(!parent.isValid()){
+        return m_items.size();
+    }
+    if(!isNodeIndex(parent) || (parent.column() != NAME)){
+        return 0;
+    }
+    return getItem(parent)->plugs.size();
+}
+
+bool NodePropertyModel::hasChildren(const QModelIndex& parent) const
+{
+    if(!parent.isValid()){
+        return !m_items.isEmpty();
+    }
+    if(!isNodeIndex(parent) || (parent.column() != NAME)){
+        return false;
+    }
+    NodeItem* item = getItem(parent);
+    return !item->hasFetchedPlugs || !item->plugs.isEmpty();
+}
+
+bool NodePropertyModel::canFetchMore(const QModelIndex& parent) const
+{
+    if(!isNodeIndex(parent)){
+        return false;
+    }
+    return !getItem(parent)->hasFetchedPlugs;
+}
+
+void NodePropertyModel::fetchMore(const QModelIndex& parent)
+{
+    if(!canFetchMore(parent)){
+        return;
+    }
+    NodeItem* item = getItem(parent);
+    item->hasFetchedPlugs = true;
+    QList<zodiac::PlugHandle> plugs = item->node->getPlugHandles();
+    if(plugs.isEmpty()){
+        return;
+    }
+    beginInsertRows(parent.sibling(parent.row(), NAME), 0, plugs.size()-1);
+    item->plugs = plugs;
+    endInsertRows();
+}
+
+QVariant NodePropertyModel::data(const QModelIndex& index, int role) const
+{
+    if(!index.isValid()){
+        return QVariant();
+    }
+    NodeItem* item = getItem(index);
+
+    // node row
+    if(isNodeIndex(index)){
+        switch(index.column()){
+        case NAME:
+            if((role==Qt::DisplayRole) || (role==Qt::EditRole)){
+                return item->node->getName();
+            }
+            break;
+        case ACTION:
+            if(role==Qt::DecorationRole){
+                return m_addIcon;
+            } else if(role==Qt::StatusTipRole){
+                return QString("Add a new Plug to the Node.");
+            }
+            break;
+        }
+        return QVariant();
+    }
+
+    // plug row
+    const zodiac::PlugHandle& plug = item->plugs.at(index.row());
+    if(!plug.isValid()){
+        return QVariant();
+    }
+    switch(index.column()){
+    case NAME:
+        if((role==Qt::DisplayRole) || (role==Qt::EditRole)){
+            return plug.getName();
+        }
+        break;
+    case DIRECTION:
+        if(role==Qt::DecorationRole){
+            return plug.isIncoming() ? m_incomingIcon : m_outgoingIcon;
+        } else if(role==Qt::StatusTipRole){
+            return QString("Toggle the direction of the Plug from 'incoming' to 'outgoing' and vice versa.");
+        }
+        break;
+    case ACTION:
+        if(role==Qt::DecorationRole){
+            return m_removeIcon;
+        } else if(role==Qt::StatusTipRole){
+            return QString("Delete the Plug from its Node");
+        }
+        break;
+    }
+    return QVariant();
+}
+
+bool NodePropertyModel::setData(const QModelIndex& index, const QVariant& value, int role)
+{
+    if(!index.isValid() || (index.column() != NAME) || (role != Qt::EditRole)){
+        return false;
+    }
+    NodeItem* item = getItem(index);
+    QString newName = value.toString();
+
+    if(isNodeIndex(index)){
+        if(item->node->getName() == newName){
+            return false;
+        }
+        item->node->rename(newName);
+    } else {
+        const zodiac::PlugHandle& plug = item->plugs.at(index.row());
+        if(item->node->renamePlug(plug.getName(), newName).isEmpty()){
+            return false;
+        }
+    }
+    emit dataChanged(index, index);
+    return true;
+}
+
+Qt::ItemFlags NodePropertyModel::flags(const QModelIndex& index) const
+{
+    if(!index.isValid()){
+        return Qt::NoItemFlags;
+    }
+    if(index.column()==NAME){
+        return Qt::ItemIsEnabled | Qt::ItemIsEditable;
+    }
+    return Qt::ItemIsEnabled;
+}
+
+NodePropertyModel::NodeItem* NodePropertyModel::getItem(const QModelIndex& index) const
+{
+    if(index.internalPointer()){
+        return static_cast<NodeItem*>(index.internalPointer());
+    }
+    return m_items.at(index.row());
+}
+
+int NodePropertyModel::getRow(const NodeItem* item) const
+{
+    QList<int>::const_iterator removedBegin = m_removedRows.constBegin()+m_pendingRemovalCount;
+    return item->row - int(std::lower_bound(removedBegin, m_removedRows.constEnd(), item->row) - removedBegin);
+}
+
+void NodePropertyModel::updateRows(int first)
+{
+    for(int row = first; row < m_items.size(); ++row){
+        m_items[row]->row = row;
+    }
+}
+
+void NodePropertyModel::deleteItems()
+{
+    qDeleteAll(m_items);
+    m_items.clear();
+    m_itemForNode.clear();
+}
@@ -0,0 +1,364 @@
+//
+//    ZodiacGraph - A general-purpose, circular node graph UI module.
+//    Copyright (C) 2015  Clemens Sielaff
+//
+//    The MIT License
+//
+//    Permission is hereby granted, free of charge, to any person obtaining a copy of
+//    this software and associated documentation files (the "Software"), to deal in
+//    the Software without restriction, including without limitation the rights to
+//    use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+//    of the Software, and to permit persons to whom the Software is furnished to do so,
+//    subject to the following conditions:
+//
+//    The above copyright notice and this permission notice shall be included in all
+//    copies or substantial portions of the Software.
+//
+//    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//    SOFTWARE.
+//
+
+#ifndef NODEPROPERTYMODEL_H
+#define NODEPROPERTYMODEL_H
+
+#include <QAbstractItemModel>
+#include <QHash>
+#include <QIcon>
+
+#include "zodiacgraph/nodehandle.h"
+#include "zodiacgraph/plughandle.h"
+
+class MainCtrl;
+class NodeCtrl;
+
+///
+/// \brief Item model exposing the properties of the selected nodes to the PropertyEditor.
+///
+/// Each top-level row represents a node, its children are the plugs of that node.
+/// The plugs of a node are only collected, once the view asks for them through fetchMore().
+///
+/// The model has three columns:
+/// the name, the direction of a plug and a button-column to add a plug to a node or to remove a plug from it.
+///
+class NodePropertyModel : public QAbstractItemModel
+{
+    Q_OBJECT
+
+public: // enums
+
+    ///
+    /// \brief The columns of the model.
+    ///
+    enum Column {
+        NAME = 0,
+        DIRECTION = 1,
+        ACTION = 2,
+        COLUMN_COUNT = 3,
+    };
+
+public: // methods
+
+    ///
+    /// \brief Constructor.
+    ///
+    /// \param [in] parent  Qt parent.
+    ///
+    explicit NodePropertyModel(QObject* parent);
+
+    ///
+    /// \brief Destructor.
+    ///
+    ~NodePropertyModel();
+
+    ///
+    /// \brief Defines a new main controller managing the displayed nodes.
+    ///
+    /// \param [in] mainCtrl    The main controller.
+    ///
+    void setMainCtrl(MainCtrl* mainCtrl) {Q_ASSERT(!m_mainCtrl); m_mainCtrl = mainCtrl;}
+
+    ///
+    /// \brief Replaces all displayed nodes.
+    ///
+    /// \param [in] nodes   Handles of all nodes to display.
+    ///
+    void setNodes(const QList<zodiac::NodeHandle>& nodes);
+
+    ///
+    /// \brief Adds nodes to the top of the model.
+    ///
+    /// Nodes that are already displayed are ignored.
+    ///
+    /// \param [in] nodes   Handles of the nodes to add.
+    ///
+    /// \return             Number of added rows.
+    ///
+    int addNodes(const QList<zodiac::NodeHandle>& nodes);
+
+    ///
+    /// \brief Removes nodes from the model.
+    ///
+    /// Nodes that are not displayed are ignored.
+    ///
+    /// \param [in] nodes   Handles of the nodes to remove.
+    ///
+    void removeNodes(const QList<zodiac::NodeHandle>& nodes);
+
+    ///
+    /// \brief Adds a new plug to the node at the given index.
+    ///
+    /// Hitting the add-Plug button creates incoming and outgoing Plug%s alternately.
+    ///
+    /// \param [in] nodeIndex   Index of a node row.
+    ///
+    void createPlug(const QModelIndex& nodeIndex);
+
+    ///
+    /// \brief Changes the direction of the plug at the given index.
+    ///
+    /// \param [in] plugIndex   Index of a plug row.
+    ///
+    void togglePlugDirection(const QModelIndex& plugIndex);
+
+    ///
+    /// \brief Removes the plug at the given index from its node.
+    ///
+    /// \param [in] plugIndex   Index of a plug row.
+    ///
+    void removePlug(const QModelIndex& plugIndex);
+
+    ///
+    /// \brief Checks if the given index belongs to a node row.
+    ///
+    /// \param [in] index   Index to test.
+    ///
+    /// \return <i>true</i> if the index belongs to a node row -- <i>false</i> if it belongs to a plug row.
+    ///
+    bool isNodeIndex(const QModelIndex& index) const {return index.isValid() && !index.internalPointer();}
+
+public: // QAbstractItemModel interface
+
+    ///
+    /// \brief Index of a node row, if the parent is invalid -- or of a plug row, if the parent is a node row.
+    ///
+    /// Plug indices store nothing but a pointer to the NodeItem of their node.
+    ///
+    /// \param [in] row     Row of the index.
+    /// \param [in] column  Column of the index.
+    /// \param [in] parent  Parent index.
+    ///
+    /// \return             The requested index, or an invalid index if there is none.
+    ///
+    QModelIndex index(int row, int column, const QModelIndex& parent = QModelIndex()) const override;
+
+    ///
+    /// \brief The node row of a plug index -- or an invalid index for a node index.
+    ///
+    /// \param [in] child   Any index of the model.
+    ///
+    /// \return             The parent of the given index.
+    ///
+    QModelIndex parent(const QModelIndex& child) const override;
+
+    ///
+    /// \brief Number of nodes at the top level -- or number of fetched plugs below a node row.
+    ///
+    /// \param [in] parent  Parent index.
+    ///
+    /// \return             Number of rows below the parent.
+    ///
+    int rowCount(const QModelIndex& parent = QModelIndex()) const override;
+
+    ///
+    /// \brief All rows have the same number of columns.
+    ///
+    /// \return Number of columns.
+    ///
+    int columnCount(const QModelIndex& = QModelIndex()) const override {return COLUMN_COUNT;}
+
+    ///
+    /// \brief Node rows report children until their plugs were fetched, so the view can offer to expand them.
+    ///
+    /// \param [in] parent  Parent index.
+    ///
+    /// \return             <i>true</i> if there are or might be rows below the parent -- <i>false</i> otherwise.
+    ///
+    bool hasChildren(const QModelIndex& parent = QModelIndex()) const override;
+
+    ///
+    /// \brief Checks whether the plugs of a node row have yet to be fetched.
+    ///
+    /// \param [in] parent  Parent index.
+    ///
+    /// \return             <i>true</i> if the parent is a node row with unfetched plugs -- <i>false</i> otherwise.
+    ///
+    bool canFetchMore(const QModelIndex& parent) const override;
+
+    ///
+    /// \brief Collects the plugs of a node row, is called by the view when the row is expanded.
+    ///
+    /// \param [in] parent  Index of a node row.
+    ///
+    void fetchMore(const QModelIndex& parent) override;
+
+    ///
+    /// \brief Data of the given index.
+    ///
+    /// \param [in] index   Index whose data to return.
+    /// \param [in] role    Requested data role.
+    ///
+    /// \return             The requested data or an invalid QVariant.
+    ///
+    QVariant data(const QModelIndex& index, int role = Qt::DisplayRole) const override;
+
+    ///
+    /// \brief Renames the node or plug of the given index.
+    ///
+    /// \param [in] index   Index of a name cell.
+    /// \param [in] value   New name proposal.
+    /// \param [in] role    Must be Qt::EditRole.
+    ///
+    /// \return             <i>true</i> if a node or plug was renamed -- <i>false</i> otherwise.
+    ///
+    bool setData(const QModelIndex& index, const QVariant& value, int role = Qt::EditRole) override;
+
+    ///
+    /// \brief Only name cells are editable.
+    ///
+    /// \param [in] index   Index whose flags to return.
+    ///
+    /// \return             Flags of the given index.
+    ///
+    Qt::ItemFlags flags(const QModelIndex& index) const override;
+
+private: // struct
+
+    ///
+    /// \brief A single node row of the model.
+    ///
+    struct NodeItem {
+
+        ///
+        /// \brief Controller of the displayed node.
+        ///
+        NodeCtrl* node;
+
+        ///
+        /// \brief Current row of this item in the model.
+        ///
+        /// Is not updated until all rows are removed by NodePropertyModel::removeNodes(), see getRow().
+        ///
+        int row;
+
+        ///
+        /// \brief Plugs of the node, in the order of their rows.
+        ///
+        QList<zodiac::PlugHandle> plugs;
+
+        ///
+        /// \brief Whether or not the plugs were fetched yet.
+        ///
+        bool hasFetchedPlugs;
+
+        ///
+        /// \brief Whether the next Plug created through the model is incoming or outgoing.
+        ///
+        bool nextPlugIsIncoming;
+    };
+
+private: // methods
+
+    ///
+    /// \brief The NodeItem of a node or plug index.
+    ///
+    /// \param [in] index   Any valid index of the model.
+    ///
+    /// \return             The NodeItem of the node row or of the parent node row of a plug row.
+    ///
+    NodeItem* getItem(const QModelIndex& index) const;
+
+    ///
+    /// \brief The current row of a NodeItem.
+    ///
+    /// While removeNodes() is in progress, the stored row of an item is too large by the number of rows already
+    /// removed before it.
+    ///
+    /// \param [in] item    Any NodeItem of the model.
+    ///
+    /// \return             Current row of the item.
+    ///
+    int getRow(const NodeItem* item) const;
+
+    ///
+    /// \brief Updates the row of all NodeItem%s starting with the given one.
+    ///
+    /// \param [in] first   First row to update.
+    ///
+    void updateRows(int first = 0);
+
+    ///
+    /// \brief Deletes all NodeItem%s without notifying any view.
+    ///
+    void deleteItems();
+
+private: // members
+
+    ///
+    /// \brief The main controller providing the NodeCtrl%s of the displayed nodes.
+    ///
+    MainCtrl* m_mainCtrl;
+
+    ///
+    /// \brief All node rows in order.
+    ///
+    QList<NodeItem*> m_items;
+
+    ///
+    /// \brief All node rows, identified by the handle of their node.
+    ///
+    QHash<zodiac::NodeHandle, NodeItem*> m_itemForNode;
+
+    ///
+    /// \brief All rows removed by the current call to removeNodes() in ascending order, empty otherwise.
+    ///
+    QList<int> m_removedRows;
+
+    ///
+    /// \brief Number of rows at the front of m_removedRows that have not been removed from the model yet.
+    ///
+    int m_pendingRemovalCount;
+
+    ///
+    /// \brief Icon of incoming plugs.
+    ///
+    QIcon m_incomingIcon;
+
+    ///
+    /// \brief Icon of outgoing plugs.
+    ///
+    QIcon m_outgoingIcon;
+
+    ///
+    /// \brief Icon of the add-plug button.
+    ///
+    QIcon m_addIcon;
+
+    ///
+    /// \brief Icon of the plug-removal button.
+    ///
+    QIcon m_removeIcon;
+
+private: // static members
+
+    ///
+    /// \brief Default plug name.
+    ///
+    static QString s_defaultPlugName;
+};
+
+#endif // NODEPROPERTYMODEL_H
@@ -1,54 +1,74 @@
 #include "propertyeditor.h"
 
-#include <QVBoxLayout>
+#include <QHeaderView>
 
-#include "collapsible.h"
-#include "nodeproperties.h"
-#include "mainctrl.h"
+const int PropertyEditor::s_maxWidth = 404;
+const int PropertyEditor::s_buttonColumnWidth = 24;
+const int PropertyEditor::s_autoExpandLimit = 8;
 
 PropertyEditor::PropertyEditor(QWidget *parent)
-    : QScrollArea(parent)
-    , m_mainCtrl(nullptr)
+    : QTreeView(parent)
+    , m_model(new NodePropertyModel(this))
 {
-    // setup the scroll area
+    // setup the view
     setFrameShape(QFrame::NoFrame);
-    setWidgetResizable(true);
-    setMaximumWidth(Collapsible::getMaximumWidth()+4);
+    setMaximumWidth(s_maxWidth);
+    setHeaderHidden(true);
+    setIconSize(QSize(16, 16));
+    setSelectionMode(QAbstractItemView::NoSelection);
+    setEditTriggers(QAbstractItemView::DoubleClicked | QAbstractItemView::EditKeyPressed);
+    setUniformRowHeights(true); // lets the view lay out rows without asking for the size of each one
+    setModel(m_model);
 
-    // set up the view widget
-    QWidget* viewWidget = new QWidget(this);
-    setWidget(viewWidget);
+    // the name takes up all available space, the button columns are fixed so their width is never measured
+    header()->setStretchLastSection(false);
+    header()->setSectionResizeMode(NodePropertyModel::NAME, QHeaderView::Stretch);
+    header()->setSectionResizeMode(NodePropertyModel::DIRECTION, QHeaderView::Fixed);
+    header()->setSectionResizeMode(NodePropertyModel::ACTION, QHeaderView::Fixed);
+    header()->resizeSection(NodePropertyModel::DIRECTION, s_buttonColumnWidth);
+    header()->resizeSection(NodePropertyModel::ACTION, s_buttonColumnWidth);
 
-    // ... and the layout of the view widget
-    m_layout = new QVBoxLayout(viewWidget);
-    m_layout->setContentsMargins(QMargins(4,0,0,0));
-    m_layout->addStretch();
+    connect(this, SIGNAL(clicked(QModelIndex)), this, SLOT(itemClicked(QModelIndex)));
 }
 
 void PropertyEditor::showNodes(const QList<zodiac::NodeHandle>& selection)
 {
-    Q_ASSERT(m_mainCtrl);
-
-    // collect all collapsibles to remove
-    QVector<zodiac::NodeHandle> removed;
-    for(QHash<zodiac::NodeHandle, Collapsible*>::iterator i = m_nodes.begin(); i != m_nodes.end(); ++i){
-        if(!selection.contains(i.key())){
-            m_layout->removeWidget(i.value());
-            removed.append(i.key());
+    m_model->setNodes(selection);
+    expandNodes(m_model->rowCount());
+}
+
+void PropertyEditor::updateNodes(const QList<zodiac::NodeHandle>& selected,
+                                 const QList<zodiac::NodeHandle>& deselected)
+{
+    m_model->removeNodes(deselected);
+    expandNodes(m_model->addNodes(selected)); // new nodes are inserted at the top
+}
+
+void PropertyEditor::itemClicked(const QModelIndex& index)
+{
+    switch(index.column()){
+    case NodePropertyModel::DIRECTION:
+        if(!m_model->isNodeIndex(index)){
+            m_model->togglePlugDirection(index);
         }
+        break;
+    case NodePropertyModel::ACTION:
+        if(m_model->isNodeIndex(index)){
+            m_model->createPlug(index);
+            expand(index.sibling(index.row(), NodePropertyModel::NAME));
+        } else {
+            m_model->removePlug(index);
+        }
+        break;
     }
-    // ... and remove them after the iteration has finished
-    for(zodiac::NodeHandle node : removed){
-        m_nodes.take(node)->deleteLater();
-    }
+}
 
-    // then create the new collapsibles
-    for(zodiac::NodeHandle node : selection){
-        if(!m_nodes.contains(node)){
-            Collapsible* collapsible = new Collapsible(this);
-            collapsible->setWidget(new NodeProperties(m_mainCtrl->getCtrlForHandle(node), collapsible));
-            m_layout->insertWidget(0, collapsible); // insert the new Collapsible at the top
-            m_nodes.insert(node, collapsible);
-        }
+void PropertyEditor::expandNodes(int count)
+{
+    if(m_model->rowCount() > s_autoExpandLimit){
+        return;
+    }
+    for(int row = 0; row < count; ++row){
+        expand(m_model->index(row, NodePropertyModel::NAME));
     }
 }
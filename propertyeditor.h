@@ -26,16 +26,21 @@
 #ifndef NODEPROPERTYEDITOR_H
 #define NODEPROPERTYEDITOR_H
 
-#include <QScrollArea>
-#include <QHash>
+#include <QTreeView>
 
+#include "nodepropertymodel.h"
 #include "zodiacgraph/nodehandle.h"
 
-class Collapsible;
 class MainCtrl;
-class QVBoxLayout;
 
-class PropertyEditor : public QScrollArea
+///
+/// \brief Displays and edits the properties of all selected nodes.
+///
+/// The properties are provided by a NodePropertyModel.
+/// The view only creates rows that are visible and a single editor at a time, no matter how many nodes are selected or
+/// how many plugs they have.
+///
+class PropertyEditor : public QTreeView
 {
     Q_OBJECT
 
@@ -56,31 +61,76 @@ public: // methods
     ///
     /// \param [in] mainCtrl    The main controller managing this PropertyEditor.
     ///
-    void setMainCtrl(MainCtrl* mainCtrl) {Q_ASSERT(!m_mainCtrl); m_mainCtrl = mainCtrl;}
+    void setMainCtrl(MainCtrl* mainCtrl) {m_model->setMainCtrl(mainCtrl);}
 
     ///
-    /// \brief Shows 0-n NodeProperty%s in the PropertyEditor.
+    /// \brief Shows 0-n nodes in the PropertyEditor.
     ///
-    /// \param [in] selection   Handles of all nodes for which to display NodeProperty%s.
+    /// \param [in] selection   Handles of all nodes to display.
     ///
     void showNodes(const QList<zodiac::NodeHandle>& selection);
 
+    ///
+    /// \brief Adds and removes nodes according to a change in the selection.
+    ///
+    /// Only touches the rows of the changed nodes, which makes it preferable to showNodes() for small changes to
+    /// large selections.
+    ///
+    /// \param [in] selected    Handles of nodes that were added to the selection.
+    /// \param [in] deselected  Handles of nodes that were removed from the selection.
+    ///
+    void updateNodes(const QList<zodiac::NodeHandle>& selected, const QList<zodiac::NodeHandle>& deselected);
+
+public: // static methods
+
+    ///
+    /// \brief Returns the maximum width of the PropertyEditor in pixels.
+    ///
+    /// \return The maximum width of the PropertyEditor in pixels.
+    ///
+    static int getMaximumWidth() {return s_maxWidth;}
+
+private slots:
+
+    ///
+    /// \brief Called when an item in the view was clicked, acts as the button of the direction and action columns.
+    ///
+    /// \param [in] index   Index of the clicked item.
+    ///
+    void itemClicked(const QModelIndex& index);
+
+private: // methods
+
+    ///
+    /// \brief Expands the first node rows, if there are only a few nodes displayed.
+    ///
+    /// \param [in] count   Number of node rows from the top to expand.
+    ///
+    void expandNodes(int count);
+
 private: // members
 
     ///
-    /// \brief The main controller managing this PropertyEditor.
+    /// \brief Model providing the properties of the displayed nodes.
+    ///
+    NodePropertyModel* m_model;
+
+private: // static members
+
+    ///
+    /// \brief Maximum width of the PropertyEditor in pixels.
     ///
-    MainCtrl* m_mainCtrl;
+    static const int s_maxWidth;
 
     ///
-    /// \brief Layout of the widget displayed in the scroll area, manages the individual Collapsible%s.
+    /// \brief Width of the direction and action columns in pixels.
     ///
-    QVBoxLayout* m_layout;
+    static const int s_buttonColumnWidth;
 
     ///
-    /// \brief All Collapsible%s representing NodeCtrl%s, identified by their NodeHandle.
+    /// \brief New nodes are only expanded automatically, if no more than this many nodes are displayed.
     ///
-    QHash<zodiac::NodeHandle, Collapsible*> m_nodes;
+    static const int s_autoExpandLimit;
 };
 
 #endif // NODEPROPERTYEDITOR_H
@@ -1,6 +1,8 @@
 #include "baseedge.h"
 
 #include <QPainter>
+#include <QtMath>
+#include <QTimerEvent>
 #include <QStyleOptionGraphicsItem>
 
 #include "edgearrow.h"
@@ -8,6 +10,8 @@
 #include "utils.h"
 #include "scene.h"
 
+static QVector<QRectF> createDirtyRects(const QList<QPolygonF>& polylines, qreal margin, qreal maxSize);
+
 namespace zodiac {
 
 qreal BaseEdge::s_width = 2.5;
@@ -16,6 +20,9 @@ qreal BaseEdge::s_secondaryFadeInDuration = 200.;
 qreal BaseEdge::s_secondaryFadeOutDuration = 400.;
 QEasingCurve BaseEdge::s_secondaryFadeInCurve = QEasingCurve::OutQuart;
 QEasingCurve BaseEdge::s_secondaryFadeOutCurve = QEasingCurve::InCubic;
+qreal BaseEdge::s_boundsSlack = 32.;
+qreal BaseEdge::s_dirtyRectSize = 64.;
+int BaseEdge::s_labelPageDuration = 2500;
 QPen BaseEdge::s_pen = QPen(QBrush(s_color), s_width, Qt::SolidLine, Qt::RoundCap);
 
 BaseEdge::BaseEdge(Scene* scene)
@@ -25,6 +32,16 @@ BaseEdge::BaseEdge(Scene* scene)
     , m_path(QPainterPath())
     , m_secondaryOpacity(0.)
     , m_label(nullptr)
+    , m_labelText(QString())
+    , m_isLabelTextValid(false)
+    , m_labelPage(0)
+    , m_stroke(QPainterPath())
+    , m_isStrokeValid(false)
+    , m_strokedWidth(0.)
+    , m_bounds(QRectF())
+    , m_shapeBounds(QRectF())
+    , m_isInEdgeIndex(false)
+    , m_dirtyRects(QVector<QRectF>())
 {
     m_scene->addItem(this);
 
@@ -47,40 +64,61 @@ BaseEdge::BaseEdge(Scene* scene)
     m_secondaryFadeOut.setTargetObject(this);
     m_secondaryFadeOut.setPropertyName("secondaryOpacity");
     m_secondaryFadeOut.setEndValue(0.);
+    connect(&m_secondaryFadeOut, SIGNAL(finished()), this, SLOT(releaseLabel()));
 }
 
 BaseEdge::~BaseEdge()
 {
-    setLabelText("");
+    discardLabel();
+    if(m_isInEdgeIndex){
+        m_scene->getEdgeIndex().removeEdge(this);
+    }
+}
+
+void BaseEdge::discardLabel()
+{
+    m_secondaryFadeIn.stop();
+    m_secondaryFadeOut.stop();
+    m_secondaryOpacity = 0.;
+    releaseLabel();
 }
 
 void BaseEdge::setLabelText(const QString& text)
 {
+    m_labelText = text;
+    m_isLabelTextValid = true;
+
+    // the label item only exists while it is shown
+    if(!m_label){
+        return;
+    }
     if(text.isEmpty()){
-        // remove an existing label
-        if(m_label){
-            m_arrow->setLabel(nullptr);
-            m_scene->removeItem(m_label);
-            delete m_label;
-            m_label = nullptr;
-        }
+        m_secondaryFadeIn.stop();
+        updateSecondaryOpacity(0.);
+        releaseLabel();
     } else {
-        // create a new or modify an existing label
-        if(!m_label){
-            m_label = new EdgeLabel();
-            m_scene->addItem(m_label);
-            m_arrow->setLabel(m_label);
-        }
         m_label->setText(text);
+        placeArrowAt(0.5); // re-centers the label
     }
 }
 
+QString BaseEdge::getLabelText()
+{
+    return m_labelText;
+}
+
+int BaseEdge::getLabelPageCount()
+{
+    return 1;
+}
+
 void BaseEdge::setVisible(bool visible)
 {
     // if you turn invisible, make sure all secondaries are invisible too
     if(!visible){
         m_secondaryFadeIn.stop(); // in case the secondaries are currently fading in
         updateSecondaryOpacity(0.);
+        releaseLabel();
     }
     return QGraphicsObject::setVisible(visible);
 }
@@ -90,14 +128,72 @@ void BaseEdge::updateStyle()
     if(m_label){
         m_label->updateStyle();
     }
+    updateBounds(); // the edge width might have changed
     placeArrowAt(0.5);
     update();
 }
 
+void BaseEdge::updateLabel()
+{
+    if(m_label){
+        m_label->update();
+    }
+}
+
+void BaseEdge::updateBounds()
+{
+    QRectF shapeBounds = getShapeBounds();
+    QList<QPolygonF> polylines = getIndexPolylines();
+    QRectF bounds;
+
+    // register the exact footprint with the edge index and only report the snapped bounds to the scene
+    EdgeIndex& edgeIndex = m_scene->getEdgeIndex();
+    if(m_scene->getEdgeIndexMethod()==EdgeIndexMethod::EDGE_GRID){
+        QList<QPolygonF> scenePolylines = polylines;
+        QTransform transform = sceneTransform();
+        if(!transform.isIdentity()){
+            for(QPolygonF& polyline : scenePolylines){
+                polyline = transform.map(polyline);
+            }
+        }
+        edgeIndex.updateEdge(this, scenePolylines, s_width);
+        bounds = edgeIndex.snapToGrid(shapeBounds);
+    } else {
+        if(m_isInEdgeIndex){
+            edgeIndex.removeEdge(this);
+        }
+
+        // keep the reported bounds as long as they contain the shape without too much slack
+        QMarginsF slack(s_boundsSlack, s_boundsSlack, s_boundsSlack, s_boundsSlack);
+        if((m_bounds.contains(shapeBounds)) && (shapeBounds.marginsAdded(slack*2.).contains(m_bounds))){
+            bounds = m_bounds;
+        } else {
+            bounds = shapeBounds.marginsAdded(slack);
+        }
+    }
+
+    // changing the reported bounds invalidates the whole old and new bounds in the view,
+    // otherwise only the areas along the old and new path are repainted
+    QVector<QRectF> dirtyRects = createDirtyRects(polylines, s_width+1., s_dirtyRectSize); // +1 for antialiasing
+    if(bounds!=m_bounds){
+        prepareGeometryChange();
+        m_bounds = bounds;
+    } else {
+        for(const QRectF& dirtyRect : m_dirtyRects){
+            update(dirtyRect);
+        }
+        for(const QRectF& dirtyRect : dirtyRects){
+            update(dirtyRect);
+        }
+    }
+    m_shapeBounds = shapeBounds;
+    m_dirtyRects.swap(dirtyRects);
+    m_isStrokeValid = false;
+}
+
 QRectF BaseEdge::boundingRect() const
 {
-    qreal overdraw = s_width/2.;
-    return m_path.boundingRect().marginsAdded(QMarginsF(overdraw,overdraw,overdraw,overdraw));
+    return m_bounds;
 }
 
 void BaseEdge::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* /* widget */)
@@ -109,23 +205,88 @@ void BaseEdge::paint(QPainter* painter, const QStyleOptionGraphicsItem* option,
 
 QPainterPath BaseEdge::shape() const
 {
-    return QPainterPathStroker(s_pen).createStroke(m_path);
+    // only re-create the stroke if the path or the edge width have changed since the last call
+    if((!m_isStrokeValid) || (m_strokedWidth!=s_width)){
+        m_stroke = QPainterPathStroker(s_pen).createStroke(getStrokedPath());
+        m_isStrokeValid = true;
+        m_strokedWidth = s_width;
+    }
+    return m_stroke;
+}
+
+QPainterPath BaseEdge::getStrokedPath() const
+{
+    return m_path;
+}
+
+bool BaseEdge::contains(const QPointF& point) const
+{
+    return isNear(point, 0.);
+}
+
+bool BaseEdge::collidesWithPath(const QPainterPath& path, Qt::ItemSelectionMode mode) const
+{
+    QRectF pathBounds = path.boundingRect();
+    if(!m_shapeBounds.intersects(pathBounds)){
+        return false;
+    }
+
+    // a small path, like the area under the cursor, is covered by a circle around its center
+    if(mode==Qt::IntersectsItemShape){
+        qreal radius = qSqrt((pathBounds.width()*pathBounds.width())+(pathBounds.height()*pathBounds.height()))/2.;
+        if(radius<=s_width/2.){
+            return isNear(pathBounds.center(), radius);
+        }
+    }
+    return QGraphicsObject::collidesWithPath(path, mode);
+}
+
+bool BaseEdge::collidesWithItem(const QGraphicsItem* other, Qt::ItemSelectionMode mode) const
+{
+    if((!other) || (!m_shapeBounds.intersects(mapRectFromItem(other, other->boundingRect())))){
+        return false;
+    }
+    return QGraphicsObject::collidesWithItem(other, mode);
+}
+
+qreal BaseEdge::getDistanceTo(const QPointF& /* point */) const
+{
+    return -1.;
+}
+
+QRectF BaseEdge::getShapeBounds() const
+{
+    qreal overdraw = s_width/2.;
+    return m_path.boundingRect().marginsAdded(QMarginsF(overdraw,overdraw,overdraw,overdraw));
+}
+
+QList<QPolygonF> BaseEdge::getIndexPolylines() const
+{
+    return m_path.toSubpathPolygons();
 }
 
 void BaseEdge::hoverEnterEvent(QGraphicsSceneHoverEvent* event)
 {
-    if(m_label){
+    if(createLabel()){
+        m_secondaryFadeOut.stop(); // in case the label is currently fading out
         m_secondaryFadeIn.setStartValue(m_secondaryOpacity);
         m_secondaryFadeIn.setDuration((1.0-m_secondaryOpacity)*s_secondaryFadeInDuration);
         m_secondaryFadeIn.setEasingCurve(s_secondaryFadeInCurve);
         m_secondaryFadeIn.start();
+
+        // show one page of a long label after the other
+        if(getLabelPageCount()>1){
+            m_labelPageTimer.start(s_labelPageDuration, this);
+        }
     }
     QGraphicsObject::hoverEnterEvent(event);
 }
 
 void BaseEdge::hoverLeaveEvent(QGraphicsSceneHoverEvent* event)
 {
+    m_labelPageTimer.stop();
     if(m_label){
+        m_secondaryFadeIn.stop(); // in case the label is still fading in
         m_secondaryFadeOut.setStartValue(m_secondaryOpacity);
         m_secondaryFadeOut.setDuration(m_secondaryOpacity*s_secondaryFadeOutDuration);
         m_secondaryFadeOut.setEasingCurve(s_secondaryFadeOutCurve);
@@ -141,4 +302,157 @@ void BaseEdge::updateSecondaryOpacity(qreal opacity)
     }
     m_secondaryOpacity=opacity;
 }
+
+void BaseEdge::invalidateLabelText()
+{
+    m_isLabelTextValid = false;
+
+    // update a label that is currently shown right away
+    if(m_label){
+        setLabelText(getLabelText());
+    }
+}
+
+void BaseEdge::timerEvent(QTimerEvent* event)
+{
+    if(event->timerId()!=m_labelPageTimer.timerId()){
+        QGraphicsObject::timerEvent(event);
+        return;
+    }
+
+    // advance to the next page, the label might have lost its other pages in the meantime
+    int pageCount = getLabelPageCount();
+    if((!m_label) || (pageCount<=1)){
+        m_labelPageTimer.stop();
+        return;
+    }
+    m_labelPage = (m_labelPage+1)%pageCount;
+    invalidateLabelText();
+}
+
+void BaseEdge::releaseLabel()
+{
+    // only delete the label once it has completely faded out
+    if((!m_label) || (m_secondaryOpacity>0.)){
+        return;
+    }
+    m_arrow->setLabel(nullptr);
+    m_scene->removeItem(m_label);
+    delete m_label;
+    m_label = nullptr;
+}
+
+bool BaseEdge::isNear(const QPointF& point, qreal tolerance) const
+{
+    // reject points outside the bounds or away from the cells of the edge early
+    // (the EdgeIndex registers each edge with all cells within the edge width around it)
+    QMarginsF margins(tolerance, tolerance, tolerance, tolerance);
+    if(!m_shapeBounds.marginsAdded(margins).contains(point)){
+        return false;
+    }
+    if((m_isInEdgeIndex) && (!m_scene->getEdgeIndex().isEdgeNear(this, mapToScene(point)))){
+        return false;
+    }
+
+    // use the analytical distance if possible, otherwise fall back to the stroke
+    qreal distance = getDistanceTo(point);
+    if(distance<0.){
+        if(tolerance<=0.){
+            return shape().contains(point);
+        }
+        return shape().intersects(QRectF(point, QSizeF()).marginsAdded(margins));
+    }
+    return distance <= (s_width/2.)+tolerance;
+}
+
+bool BaseEdge::createLabel()
+{
+    if(m_label){
+        return true;
+    }
+
+    // a new label always starts on its first page
+    if(m_labelPage!=0){
+        m_labelPage = 0;
+        m_isLabelTextValid = false;
+    }
+
+    // produce the label text, if it is outdated
+    if(!m_isLabelTextValid){
+        m_labelText = getLabelText();
+        m_isLabelTextValid = true;
+    }
+    if(m_labelText.isEmpty()){
+        return false;
+    }
+
+    m_label = new EdgeLabel();
+    m_label->setText(m_labelText);
+    m_scene->getCachePolicy().apply(m_label);
+    m_scene->addItem(m_label);
+    m_arrow->setLabel(m_label);
+    placeArrowAt(0.5); // places the label as well
+    return true;
+}
 } // namespace zodiac
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// HELPER
+//
+
+///
+/// \brief Covers polylines with small rectangles, each spanning one or more consecutive segments.
+///
+/// \param polylines    Polylines to cover.
+/// \param margin       Distance around the polylines that has to be covered as well.
+/// \param maxSize      Maximal width plus height of a rectangle (without margin), before a new one is started.
+///
+/// \return             Rectangles covering the polylines.
+///
+static QVector<QRectF> createDirtyRects(const QList<QPolygonF>& polylines, qreal margin, qreal maxSize)
+{
+    QVector<QRectF> result;
+    QMarginsF margins(margin, margin, margin, margin);
+    for(const QPolygonF& polyline : polylines){
+        if(polyline.isEmpty()){
+            continue;
+        }
+
+        // grow the current rectangle segment by segment, until it becomes too large
+        // (QRectF::united ignores empty rectangles, so the extent is tracked manually)
+        qreal left = polyline.first().x();
+        qreal right = left;
+        qreal top = polyline.first().y();
+        qreal bottom = top;
+        for(int i = 1; i < polyline.size(); ++i){
+            // segments longer than a single rectangle are split into pieces that fit
+            const QPointF& start = polyline.at(i-1);
+            QPointF delta = polyline.at(i)-start;
+            int pieceCount = qMax(1, qCeil(delta.manhattanLength()/maxSize));
+            QPointF previous = start;
+            for(int piece = 1; piece <= pieceCount; ++piece){
+                QPointF point = start+(delta*(qreal(piece)/pieceCount));
+                qreal grownLeft = qMin(left, point.x());
+                qreal grownRight = qMax(right, point.x());
+                qreal grownTop = qMin(top, point.y());
+                qreal grownBottom = qMax(bottom, point.y());
+                if((grownRight-grownLeft)+(grownBottom-grownTop)>maxSize){
+                    result.append(QRectF(left, top, right-left, bottom-top).marginsAdded(margins));
+                    left = qMin(previous.x(), point.x());
+                    right = qMax(previous.x(), point.x());
+                    top = qMin(previous.y(), point.y());
+                    bottom = qMax(previous.y(), point.y());
+                } else {
+                    left = grownLeft;
+                    right = grownRight;
+                    top = grownTop;
+                    bottom = grownBottom;
+                }
+                previous = point;
+            }
+        }
+        result.append(QRectF(left, top, right-left, bottom-top).marginsAdded(margins));
+    }
+    return result;
+}
@@ -32,9 +32,12 @@
 /// \brief Contains the definition of the zodiac::BaseEdge class.
 ///
 
+#include <QBasicTimer>
 #include <QGraphicsObject>
 #include <QPen>
+#include <QPolygonF>
 #include <QPropertyAnimation>
+#include <QVector>
 
 namespace zodiac {
 
@@ -59,6 +62,10 @@ class Scene;
 /// The BaseEdge class does not grant direct access to the EdgeLabel,
 /// however you can modify the EdgeLabel of a BaseEdge with the function setLabelText().
 ///
+/// The EdgeLabel is only shown while the edge is hovered, so the label item is only created when it starts to fade in
+/// and deleted again once it has faded out.
+/// Derived classes that generate their label text only do so right before the label is shown, see getLabelText().
+///
 class BaseEdge : public QGraphicsObject
 {
     Q_OBJECT
@@ -74,6 +81,11 @@ class BaseEdge : public QGraphicsObject
     ///
     friend class EdgeArrow;
 
+    ///
+    /// \brief The EdgeIndex of the Scene keeps track of whether an edge is registered with it.
+    ///
+    friend class EdgeIndex;
+
     ///
     /// \brief The opacity of the EdgeLabel (and potential other secondary edge items).
     ///
@@ -95,6 +107,13 @@ public: // methods
     ///
     virtual ~BaseEdge();
 
+    ///
+    /// \brief Deletes the EdgeLabel item immediately, if there is one, without waiting for it to fade out.
+    ///
+    /// The label text is kept, so the label is created again the next time the edge is hovered.
+    ///
+    void discardLabel();
+
     ///
     /// \brief Sets the text of this edge's EdgeLabel.
     ///
@@ -102,10 +121,32 @@ public: // methods
     /// This function can also be used to redefine the text of an existing EdgeLabel.
     /// And lastly, it is also used to delete the EdgeLabel by setting its text to "" (the empty string).
     ///
+    /// The EdgeLabel item itself is not created before the edge is hovered.
+    ///
     /// \param [in] text    Text to set this label to. Remove an existing EdgeLabel by passing "" (the empty string).
     ///
     virtual void setLabelText(const QString& text);
 
+    ///
+    /// \brief Produces the text of this edge's EdgeLabel.
+    ///
+    /// Is called right before the label is shown, if the text was invalidated with invalidateLabelText() since.
+    /// The default implementation returns the text last set with setLabelText().
+    ///
+    /// \return Text for the EdgeLabel, an empty string for no label.
+    ///
+    virtual QString getLabelText();
+
+    ///
+    /// \brief The number of pages of this edge's EdgeLabel.
+    ///
+    /// While the edge is hovered, a label with more than one page shows one page after the other.
+    /// The default implementation returns 1.
+    ///
+    /// \return Number of pages of the label, at least 1.
+    ///
+    virtual int getLabelPageCount();
+
     ///
     /// \brief Defines the visiblity of the BaseEdge.
     ///
@@ -129,6 +170,21 @@ public: // methods
     ///
     virtual void updateStyle();
 
+    ///
+    /// \brief Repaints the EdgeLabel of this edge, if there is one, discarding its item cache.
+    ///
+    void updateLabel();
+
+    ///
+    /// \brief Updates the bounds of the edge reported to the Scene and its registration in the Scene's EdgeIndex.
+    ///
+    /// Is called by derived classes after each change to the edge's path and by the Scene, when its EdgeIndexMethod
+    /// changes.
+    /// The QGraphicsScene is only notified of a geometry change, if the reported bounds have actually changed.
+    /// Otherwise, only small rectangles along the old and the new path of the edge are repainted.
+    ///
+    void updateBounds();
+
 public: // static methods
 
     ///
@@ -215,6 +271,53 @@ public: // static methods
     ///
     static inline void setSecondarylFadeOutCurve(QEasingCurve curve) {s_secondaryFadeOutCurve=curve;}
 
+    ///
+    /// \brief Slack around the shape of an edge, within which it can change without changing its reported bounds.
+    ///
+    /// Only applies if the Scene uses EdgeIndexMethod::SCENE_INDEX.
+    ///
+    /// \return Bounds slack in pixels.
+    ///
+    static inline qreal getBoundsSlack() {return s_boundsSlack;}
+
+    ///
+    /// \brief Sets a new slack around the shape of an edge, within which it can change without changing its reported
+    /// bounds.
+    ///
+    /// \param [in] slack   New bounds slack in pixels.
+    ///
+    static inline void setBoundsSlack(qreal slack) {s_boundsSlack=qMax(0., slack);}
+
+    ///
+    /// \brief Size of the rectangles along the path of an edge that are repainted when the edge changes.
+    ///
+    /// \return Maximal width plus height of a dirty rectangle in pixels.
+    ///
+    static inline qreal getDirtyRectSize() {return s_dirtyRectSize;}
+
+    ///
+    /// \brief Sets a new size of the rectangles along the path of an edge that are repainted when the edge changes.
+    ///
+    /// Smaller rectangles repaint less of the view, but are more to process.
+    ///
+    /// \param [in] size    Maximal width plus height of a dirty rectangle in pixels.
+    ///
+    static inline void setDirtyRectSize(qreal size) {s_dirtyRectSize=qMax(1., size);}
+
+    ///
+    /// \brief The time that each page of a hovered EdgeLabel is shown.
+    ///
+    /// \return Duration of a label page in milliseconds.
+    ///
+    static inline int getLabelPageDuration() {return s_labelPageDuration;}
+
+    ///
+    /// \brief Sets the time that each page of a hovered EdgeLabel is shown.
+    ///
+    /// \param [in] duration    Duration of a label page in milliseconds.
+    ///
+    static inline void setLabelPageDuration(int duration) {s_labelPageDuration=qMax(1, duration);}
+
 protected: // methods
 
     ///
@@ -236,10 +339,90 @@ protected: // methods
     ///
     /// \brief Exact boundary of the item used for collision detection among other things.
     ///
+    /// The stroke of the edge is cached and only recreated after the path or the edge width have changed.
+    ///
     /// \return Shape in local coordinates.
     ///
     QPainterPath shape() const;
 
+    ///
+    /// \brief The path that is stroked to create the shape() of the edge.
+    ///
+    /// The default implementation returns the path used to draw the edge.
+    ///
+    /// \return            Path in local coordinates.
+    ///
+    virtual QPainterPath getStrokedPath() const;
+
+    ///
+    /// \brief Tests if a point is on the edge, is used by the Scene to find the edge under the mouse cursor.
+    ///
+    /// See isNear() for details.
+    ///
+    /// \param [in] point  Point in local coordinates.
+    ///
+    /// \return            <i>true</i> if the point is on the edge -- <i>false</i> otherwise.
+    ///
+    bool contains(const QPointF& point) const;
+
+    ///
+    /// \brief Tests if a path collides with the edge, is used by the Scene to find the edge under the mouse cursor
+    /// in a transformed view and the edges within a selection area.
+    ///
+    /// Paths outside the bounds of the edge's shape are rejected right away.
+    /// A path small enough to be within reach of the edge's stroke around its center, like the area under the mouse
+    /// cursor, is tested with isNear().
+    /// Only larger paths are tested against the shape() of the edge.
+    ///
+    /// \param [in] path   Path in local coordinates.
+    /// \param [in] mode   How the path has to collide with the edge.
+    ///
+    /// \return            <i>true</i> if the path collides with the edge -- <i>false</i> otherwise.
+    ///
+    bool collidesWithPath(const QPainterPath& path, Qt::ItemSelectionMode mode = Qt::IntersectsItemShape) const;
+
+    ///
+    /// \brief Tests if another item collides with the edge.
+    ///
+    /// Items outside the bounds of the edge's shape are rejected right away, all others are tested with
+    /// collidesWithPath().
+    ///
+    /// \param [in] other  Other item.
+    /// \param [in] mode   How the other item has to collide with the edge.
+    ///
+    /// \return            <i>true</i> if the item collides with the edge -- <i>false</i> otherwise.
+    ///
+    bool collidesWithItem(const QGraphicsItem* other, Qt::ItemSelectionMode mode = Qt::IntersectsItemShape) const;
+
+    ///
+    /// \brief Calculates the distance of a point to the center line of the edge.
+    ///
+    /// The default implementation returns a negative value, meaning that the edge does not support analytical hit
+    /// testing.
+    ///
+    /// \param [in] point  Point in local coordinates.
+    ///
+    /// \return            Distance of the point to the edge or a negative value, if it cannot be calculated.
+    ///
+    virtual qreal getDistanceTo(const QPointF& point) const;
+
+    ///
+    /// \brief Calculates the tight bounds of the edge's geometry, including its stroke.
+    ///
+    /// \return            Bounds of the edge in local coordinates.
+    ///
+    virtual QRectF getShapeBounds() const;
+
+    ///
+    /// \brief Approximates the edge with polylines to register it with the Scene's EdgeIndex.
+    ///
+    /// The polylines are also used to find the areas to repaint, when the edge changes.
+    /// The polylines may deviate from the center line of the edge by at most half the width of the edge.
+    ///
+    /// \return            Polylines in local coordinates.
+    ///
+    virtual QList<QPolygonF> getIndexPolylines() const;
+
     ///
     /// \brief Called when the mouse enteres the shape of the edge.
     ///
@@ -265,6 +448,28 @@ protected: // methods
     ///
     void updateSecondaryOpacity(qreal opacity);
 
+    ///
+    /// \brief Marks the text of the EdgeLabel as outdated.
+    ///
+    /// The text is produced anew with getLabelText() the next time that the label is shown.
+    /// If the label is currently shown, its text is updated right away.
+    ///
+    void invalidateLabelText();
+
+    ///
+    /// \brief The page of the EdgeLabel that is currently shown.
+    ///
+    /// \return Current label page.
+    ///
+    inline int getLabelPage() const {return m_labelPage;}
+
+    ///
+    /// \brief Called by the label page timer to show the next page of the EdgeLabel.
+    ///
+    /// \param [in] event   Qt event object.
+    ///
+    void timerEvent(QTimerEvent* event);
+
     ///
     /// \brief Updates the shape of this BaseEdge.
     ///
@@ -336,18 +541,129 @@ protected: // static members
     ///
     static QEasingCurve s_secondaryFadeOutCurve;
 
+    ///
+    /// \brief Slack around the shape of an edge, within which it can change without changing its reported bounds.
+    ///
+    static qreal s_boundsSlack;
+
+    ///
+    /// \brief Maximal width plus height of a rectangle along the path of an edge that is repainted on change.
+    ///
+    static qreal s_dirtyRectSize;
+
+    ///
+    /// \brief Time in milliseconds that each page of a hovered EdgeLabel is shown.
+    ///
+    static int s_labelPageDuration;
+
     ///
     /// \brief Pen used to draw all DrawEdge%s.
     ///
     static QPen s_pen;
 
+private slots:
+
+    ///
+    /// \brief Deletes the EdgeLabel item, once it has completely faded out.
+    ///
+    void releaseLabel();
+
+private: // methods
+
+    ///
+    /// \brief Creates the EdgeLabel item, before it is faded in.
+    ///
+    /// Produces the label text first, if it was invalidated.
+    ///
+    /// \return <i>true</i> if the edge has a label -- <i>false</i> if its label text is empty.
+    ///
+    bool createLabel();
+
+    ///
+    /// \brief Tests if a point is within the given distance of the stroke of the edge.
+    ///
+    /// Points outside the bounds of the edge's shape or away from the cells of the edge in the EdgeIndex are rejected
+    /// early.
+    /// Then, the analytical distance of the point to the edge is used, if the derived class provides one through
+    /// getDistanceTo() and the cached shape() otherwise.
+    ///
+    /// \param [in] point      Point in local coordinates.
+    /// \param [in] tolerance  Distance to the stroke, at most half the width of the edge.
+    ///
+    /// \return                <i>true</i> if the point is near the edge -- <i>false</i> otherwise.
+    ///
+    bool isNear(const QPointF& point, qreal tolerance) const;
+
 private: // members
 
     ///
     /// \brief Label of this BaseEdge, can be <i>nullptr</i>.
     ///
+    /// Only exists while the label is shown.
+    ///
     EdgeLabel* m_label;
 
+    ///
+    /// \brief Text of the EdgeLabel, empty if the edge has no label.
+    ///
+    QString m_labelText;
+
+    ///
+    /// \brief Whether the label text is up-to-date or has to be produced with getLabelText() before it is shown.
+    ///
+    bool m_isLabelTextValid;
+
+    ///
+    /// \brief Page of the EdgeLabel that is currently shown.
+    ///
+    int m_labelPage;
+
+    ///
+    /// \brief Advances the page of the EdgeLabel, while the edge is hovered.
+    ///
+    QBasicTimer m_labelPageTimer;
+
+    ///
+    /// \brief Cached stroke of the edge's path, returned by shape().
+    ///
+    mutable QPainterPath m_stroke;
+
+    ///
+    /// \brief Whether the cached stroke still matches the path of the edge, is reset by updateBounds().
+    ///
+    mutable bool m_isStrokeValid;
+
+    ///
+    /// \brief The edge width with which the cached stroke was created.
+    ///
+    mutable qreal m_strokedWidth;
+
+    ///
+    /// \brief Bounds of the edge as reported to the QGraphicsScene.
+    ///
+    /// Are the same as the shape bounds, unless the edge is indexed through the EdgeIndex of the Scene, in which case
+    /// they are snapped to its grid.
+    ///
+    QRectF m_bounds;
+
+    ///
+    /// \brief Tight bounds of the edge's geometry.
+    ///
+    QRectF m_shapeBounds;
+
+    ///
+    /// \brief Whether the edge is registered with the EdgeIndex of the Scene.
+    ///
+    bool m_isInEdgeIndex;
+
+    ///
+    /// \brief Small rectangles covering the current path of the edge.
+    ///
+    /// When the edge changes without changing its reported bounds, only these and the rectangles of the new path are
+    /// repainted, instead of the whole bounds.
+    ///
+    QVector<QRectF> m_dirtyRects;
+
 };
 
 } // namespace zodiac
@@ -1,5 +1,9 @@
 #include "bezieredge.h"
 
+#include <QPainter>
+#include <QStyleOptionGraphicsItem>
+#include <QtMath>
+
 #include "edgearrow.h"
 #include "node.h"
 #include "plug.h"
@@ -10,6 +14,7 @@ namespace zodiac {
 
 qreal BezierEdge::s_maxCtrlDistance = 150.;
 qreal BezierEdge::s_ctrlExpansionFactor = 0.4;
+qreal BezierEdge::s_flatteningTolerance = 0.25;
 
 BezierEdge::BezierEdge(Scene* scene)
     : BaseEdge(scene)
@@ -17,6 +22,10 @@ BezierEdge::BezierEdge(Scene* scene)
     , m_ctrlPoint1(QPointF())
     , m_ctrlPoint2(QPointF())
     , m_endPoint(QPointF())
+    , m_curve(CubicBezier())
+    , m_polyline(QPolygonF())
+    , m_polylineTolerance(0.)
+    , m_paintPolylines(QHash<int, QPolygonF>())
 {
     // initialize the shape of the edge
     updateShape();
@@ -24,54 +33,99 @@ BezierEdge::BezierEdge(Scene* scene)
 
 void BezierEdge::placeArrowAt(qreal fraction)
 {
-    /// Technically, you cannot place the arrow all the way at the end of the edge because at that point, the spline
-    /// would not have a tangent to orient the arrow to.
-    /// We could of course say that if <code>fraction >= 1.0-VERY_SMALL_DELTA</code>, the direction would have to be
-    /// calculated using a point before the position ... but why bother?
-    /// It doesn't make a visual difference and would only introduce unnecessary code branching.
-    static const qreal VERY_SMALL_DELTA = 0.00001;
-
-    qreal pos = qMin(1.0-VERY_SMALL_DELTA, qMax(0.0, fraction));
-    QPointF edgeCenter = m_path.pointAtPercent(pos);
-    QPointF edgeDirection = m_path.pointAtPercent(qMin(pos+VERY_SMALL_DELTA, 1.))-edgeCenter;
+    qreal t = m_curve.parameterAtPercent(fraction);
+    QPointF edgeCenter = m_curve.pointAt(t);
+    QPointF edgeDirection = m_curve.tangentAt(t);
+
+    // the tangent vanishes where a control point coincides with an end point, use the chord instead
+    if(edgeDirection.isNull()){
+        edgeDirection = m_endPoint-m_startPoint;
+    }
     m_arrow->setTransformation(edgeCenter, std::atan2(edgeDirection.y(), edgeDirection.x()));
 }
 
 void BezierEdge::updateShape()
 {
-    prepareGeometryChange();
-
-    // create the path
-    QPainterPath bezierPath;
-    bezierPath.moveTo(m_startPoint);
-    bezierPath.cubicTo(m_ctrlPoint1, m_ctrlPoint2, m_endPoint);
-    m_path.swap(bezierPath);
+    // update the geometry, the polyline is used for the edge index as well, so it may never deviate more than half
+    // the edge width from the spline
+    m_curve = CubicBezier(m_startPoint, m_ctrlPoint1, m_ctrlPoint2, m_endPoint);
+    m_polylineTolerance = qMin(s_flatteningTolerance, s_width/2.);
+    m_polyline = m_curve.flatten(m_polylineTolerance);
+    m_paintPolylines.clear();
+    updateBounds();
 
     placeArrowAt(0.5);
 }
 
+QRectF BezierEdge::getShapeBounds() const
+{
+    qreal overdraw = s_width/2.;
+    return m_curve.getBoundingRect().marginsAdded(QMarginsF(overdraw,overdraw,overdraw,overdraw));
+}
+
+QList<QPolygonF> BezierEdge::getIndexPolylines() const
+{
+    return QList<QPolygonF>() << m_polyline;
+}
+
+QPainterPath BezierEdge::getStrokedPath() const
+{
+    QPainterPath path;
+    path.addPolygon(m_polyline);
+    return path;
+}
+
+void BezierEdge::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* /* widget */)
+{
+    painter->setClipRect(option->exposedRect);
+    painter->setPen(s_pen);
+    painter->drawPolyline(getPolyline(option->levelOfDetailFromTransform(painter->worldTransform())));
+}
+
+qreal BezierEdge::getDistanceTo(const QPointF& point) const
+{
+    return CubicBezier::getDistanceTo(point, m_polyline);
+}
+
+const QPolygonF& BezierEdge::getPolyline(qreal levelOfDetail)
+{
+    // zoom levels are bucketed in powers of two, rounded up so the tolerance is never exceeded on screen
+    int zoomBucket = qCeil(std::log2(qMax(levelOfDetail, 0.001)));
+    qreal tolerance = s_flatteningTolerance/std::ldexp(1., zoomBucket);
+    if(tolerance>=m_polylineTolerance){
+        return m_polyline;
+    }
+
+    // closer zoom levels need a finer polyline, which is kept until the shape changes
+    QHash<int, QPolygonF>::iterator it = m_paintPolylines.find(zoomBucket);
+    if(it==m_paintPolylines.end()){
+        it = m_paintPolylines.insert(zoomBucket, m_curve.flatten(tolerance));
+    }
+    return it.value();
+}
+
 QPointF BezierEdge::getCtrlPointFor(Plug* plug)
 {
-    qreal factor;
+    // calculate the control point distance
+    qreal manhattanLength = (m_endPoint-m_startPoint).manhattanLength();
+    qreal ctrlDistance = qMin(s_maxCtrlDistance, manhattanLength*s_ctrlExpansionFactor);
+    return mapFromScene(plug->scenePos())+((plug->getNormal()*ctrlDistance).toPointF()*getExpansionFactorOf(plug));
+}
+
+qreal BezierEdge::getExpansionFactorOf(Plug* plug)
+{
     switch (plug->getDirection()) {
     case PlugDirection::IN:
-        factor = plug->getNode()->getIncomingExpansionFactor();
-        break;
+        return plug->getNode()->getIncomingExpansionFactor();
     case PlugDirection::OUT:
-        factor = plug->getNode()->getOutgoingExpansionFactor();
-        break;
+        return plug->getNode()->getOutgoingExpansionFactor();
     case PlugDirection::BOTH:
-        factor = qMax(plug->getNode()->getIncomingExpansionFactor(), plug->getNode()->getOutgoingExpansionFactor());
-        break;
+        return qMax(plug->getNode()->getIncomingExpansionFactor(), plug->getNode()->getOutgoingExpansionFactor());
     default:
-        factor = 0.0;       //
         Q_ASSERT(false);    // we shouldn't ever reach these lines..
+        return 0.0;
     }
-
-    // calculate the control point distance
-    qreal manhattanLength = (m_endPoint-m_startPoint).manhattanLength();
-    qreal ctrlDistance = qMin(s_maxCtrlDistance, manhattanLength*s_ctrlExpansionFactor);
-    return plug->scenePos()+((plug->getNormal()*ctrlDistance).toPointF()*factor);
 }
 
 } // namespace zodiac
+
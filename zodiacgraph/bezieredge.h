@@ -31,7 +31,10 @@
 /// \brief Contains the definition of the zodiac::BezierEdge class.
 ///
 
+#include <QHash>
+
 #include "baseedge.h"
+#include "cubicbezier.h"
 
 namespace zodiac {
 
@@ -115,6 +118,22 @@ public: // static methods
     ///
     static inline void setCtrlExpansionFactor(qreal factor) {s_ctrlExpansionFactor=factor;}
 
+    ///
+    /// \brief Maximal distance in pixels on screen between a drawn BezierEdge and its exact spline.
+    ///
+    /// \return Flattening tolerance in pixels.
+    ///
+    static inline qreal getFlatteningTolerance() {return s_flatteningTolerance;}
+
+    ///
+    /// \brief Sets a new maximal distance in pixels on screen between a drawn BezierEdge and its exact spline.
+    ///
+    /// Smaller values produce smoother edges made from more line segments.
+    ///
+    /// \param [in] tolerance   New flattening tolerance in pixels, must be larger than 0.
+    ///
+    static inline void setFlatteningTolerance(qreal tolerance) {s_flatteningTolerance=qMax(0.01, tolerance);}
+
 protected: // methods
 
     ///
@@ -131,6 +150,60 @@ protected: // methods
     ///
     virtual void updateShape() override;
 
+    ///
+    /// \brief Calculates the tight bounds of the edge from the exact extrema of the spline.
+    ///
+    /// \return            Bounds of the edge in local coordinates.
+    ///
+    virtual QRectF getShapeBounds() const override;
+
+    ///
+    /// \brief Returns the flattened spline to register it with the Scene's EdgeIndex.
+    ///
+    /// \return            Polylines in local coordinates.
+    ///
+    virtual QList<QPolygonF> getIndexPolylines() const override;
+
+    ///
+    /// \brief Returns the flattened spline as path, whose stroke is the shape of the edge.
+    ///
+    /// \return            Path in local coordinates.
+    ///
+    virtual QPainterPath getStrokedPath() const override;
+
+    ///
+    /// \brief Paints this item using the flattened spline for the current zoom level.
+    ///
+    /// \param [in] painter  Painter used to paint the item.
+    /// \param [in] option   Provides style options for the item.
+    /// \param [in] widget   Optional widget that this item is painted on.
+    ///
+    void paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget);
+
+    ///
+    /// \brief Returns the flattened spline for a given level of detail.
+    ///
+    /// Zoom levels up to the tolerance of the polyline used for hit testing reuse that polyline.
+    /// For closer zoom levels, a finer polyline is flattened once per zoom bucket and cached until the shape of the
+    /// edge changes.
+    ///
+    /// \param [in] levelOfDetail  Scale from scene to device coordinates.
+    ///
+    /// \return                    Polyline approximating the spline.
+    ///
+    const QPolygonF& getPolyline(qreal levelOfDetail);
+
+    ///
+    /// \brief Calculates the distance of a point to the spline of the edge.
+    ///
+    /// Uses the polyline flattened with a fixed tolerance, whenever the shape of the edge changes.
+    ///
+    /// \param [in] point  Point in local coordinates.
+    ///
+    /// \return            Distance of the point to the edge.
+    ///
+    virtual qreal getDistanceTo(const QPointF& point) const override;
+
     ///
     /// \brief Returns the position of the control point of the edge for a given Plug.
     ///
@@ -144,6 +217,19 @@ protected: // methods
     ///
     QPointF getCtrlPointFor(Plug* plug);
 
+protected: // static methods
+
+    ///
+    /// \brief The expansion factor [0 -> 1] of a Plug's Node in the direction of the Plug.
+    ///
+    /// The control point of a BezierEdge only moves out from its Plug as far as the Plug has expanded.
+    ///
+    /// \param [in] plug    Plug to get the expansion factor for.
+    ///
+    /// \return             Expansion factor of the Plug.
+    ///
+    static qreal getExpansionFactorOf(Plug* plug);
+
 protected: // members
 
     ///
@@ -166,6 +252,27 @@ protected: // members
     ///
     QPointF m_endPoint;
 
+    ///
+    /// \brief Geometry of the spline, updated together with the shape of the edge.
+    ///
+    CubicBezier m_curve;
+
+    ///
+    /// \brief Flattened spline used for hit testing, the shape and the bounds of the edge, and for painting at most zoom
+    /// levels.
+    ///
+    QPolygonF m_polyline;
+
+    ///
+    /// \brief Maximal distance of the polyline to the spline.
+    ///
+    qreal m_polylineTolerance;
+
+    ///
+    /// \brief Finer polylines used for painting at close zoom levels, by zoom bucket.
+    ///
+    QHash<int, QPolygonF> m_paintPolylines;
+
 private: // static members
 
     ///
@@ -178,6 +285,11 @@ private: // static members
     /// arclengh.
     ///
     static qreal s_ctrlExpansionFactor;
+
+    ///
+    /// \brief Maximal distance in pixels on screen between a drawn BezierEdge and its exact spline.
+    ///
+    static qreal s_flatteningTolerance;
 };
 
 } // namespace zodiac
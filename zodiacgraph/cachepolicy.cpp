@@ -0,0 +1,164 @@
+#include "cachepolicy.h"
+
+#include <QPixmapCache>
+
+#include "scene.h"
+#include "utils.h"
+
+namespace zodiac {
+
+CachePolicy::CachePolicy(Scene* scene)
+    : m_scene(scene)
+    , m_memoryBudget(QPixmapCache::cacheLimit())
+    , m_areStatisticsEnabled(false)
+    , m_zoomFactor(1.)
+    , m_visibleRect(QRectF())
+{
+    for(int i = 0; i < s_classCount; ++i){
+        m_cacheModes[i] = QGraphicsItem::DeviceCoordinateCache;
+        m_renderCounts[i] = 0;
+        m_drawCounts[i] = 0;
+    }
+}
+
+void CachePolicy::update(qreal zoomFactor, const QRectF& visibleRect)
+{
+    m_zoomFactor = zoomFactor;
+    m_visibleRect = visibleRect;
+
+    // sum up the area of all visible items of each class
+    qreal areas[s_classCount] = {0., 0., 0., 0., 0., 0.};
+    for(QGraphicsItem* item : m_scene->items(visibleRect, Qt::IntersectsItemBoundingRect)){
+        int itemClass = getClassOf(item);
+        if((itemClass<0) || (!item->isVisible())){
+            continue;
+        }
+        QRectF bounds = item->boundingRect();
+        areas[itemClass] += bounds.width()*bounds.height();
+    }
+
+    // assign the cache modes by priority, as long as the estimated pixmaps fit into the budget (4 bytes per pixel)
+    static const CachedItem priorities[s_classCount] = {
+        CachedItem::NODE_LABEL, CachedItem::PLUG_LABEL, CachedItem::EDGE_LABEL,
+        CachedItem::NODE, CachedItem::PLUG, CachedItem::PERIMETER};
+    qreal remainingBudget = qreal(m_memoryBudget)*1024.;
+    QGraphicsItem::CacheMode cacheModes[s_classCount];
+    bool isAtlasEnabled = m_scene->getSpriteAtlas().isEnabled();
+    for(CachedItem cachedItem : priorities){
+        int itemClass = int(cachedItem);
+        if((isAtlasEnabled) && ((cachedItem==CachedItem::NODE) || (cachedItem==CachedItem::PLUG))){
+            cacheModes[itemClass] = QGraphicsItem::NoCache;
+            continue;
+        }
+        qreal itemBytes = areas[itemClass]*4.;
+        qreal deviceBytes = itemBytes*zoomFactor*zoomFactor;
+        if(deviceBytes<=remainingBudget){
+            cacheModes[itemClass] = QGraphicsItem::DeviceCoordinateCache;
+            remainingBudget -= deviceBytes;
+        } else if((zoomFactor<=1.) && (itemBytes<=remainingBudget)){
+            // item coordinate caches are scaled down when zoomed out, but would be blurry when zoomed in
+            cacheModes[itemClass] = QGraphicsItem::ItemCoordinateCache;
+            remainingBudget -= itemBytes;
+        } else {
+            cacheModes[itemClass] = QGraphicsItem::NoCache;
+        }
+    }
+
+    // only touch the items, if any cache mode has changed
+    bool hasChanged = false;
+    for(int i = 0; i < s_classCount; ++i){
+        if(cacheModes[i]!=m_cacheModes[i]){
+            m_cacheModes[i] = cacheModes[i];
+            hasChanged = true;
+        }
+    }
+    if(!hasChanged){
+        return;
+    }
+    for(QGraphicsItem* item : m_scene->items()){
+        apply(item);
+    }
+}
+
+void CachePolicy::refresh()
+{
+    update(m_zoomFactor, m_visibleRect);
+}
+
+void CachePolicy::apply(QGraphicsItem* item) const
+{
+    int itemClass = getClassOf(item);
+    if((itemClass>=0) && (item->cacheMode()!=m_cacheModes[itemClass])){
+        item->setCacheMode(m_cacheModes[itemClass]);
+    }
+}
+
+void CachePolicy::setMemoryBudget(int kilobytes)
+{
+    m_memoryBudget = qMax(0, kilobytes);
+    if(QPixmapCache::cacheLimit()<m_memoryBudget){
+        QPixmapCache::setCacheLimit(m_memoryBudget);
+    }
+}
+
+void CachePolicy::recordFrame(const QRectF& visibleRect)
+{
+    if(!m_areStatisticsEnabled){
+        return;
+    }
+    for(QGraphicsItem* item : m_scene->items(visibleRect, Qt::IntersectsItemBoundingRect)){
+        int itemClass = getClassOf(item);
+        if((itemClass>=0) && (item->isVisible())){
+            ++m_drawCounts[itemClass];
+        }
+    }
+}
+
+qreal CachePolicy::getHitRate(CachedItem item) const
+{
+    quint64 drawCount = m_drawCounts[int(item)];
+    if(drawCount==0){
+        return 0.;
+    }
+    return 1. - getMissRate(item);
+}
+
+qreal CachePolicy::getMissRate(CachedItem item) const
+{
+    quint64 drawCount = m_drawCounts[int(item)];
+    if(drawCount==0){
+        return 0.;
+    }
+    // an item can be rendered more than once per recorded draw, for example when it is shown in several views
+    return qMin(1., qreal(m_renderCounts[int(item)])/qreal(drawCount));
+}
+
+void CachePolicy::resetStatistics()
+{
+    for(int i = 0; i < s_classCount; ++i){
+        m_renderCounts[i] = 0;
+        m_drawCounts[i] = 0;
+    }
+}
+
+int CachePolicy::getClassOf(const QGraphicsItem* item)
+{
+    switch(item->type()){
+    case itemType::NODE_TYPE:
+        return int(CachedItem::NODE);
+    case itemType::PLUG_TYPE:
+        return int(CachedItem::PLUG);
+    case itemType::PERIMETER_TYPE:
+        return int(CachedItem::PERIMETER);
+    case itemType::NODE_LABEL_TYPE:
+        return int(CachedItem::NODE_LABEL);
+    case itemType::PLUG_LABEL_TYPE:
+        return int(CachedItem::PLUG_LABEL);
+    case itemType::EDGE_LABEL_TYPE:
+        return int(CachedItem::EDGE_LABEL);
+    default:
+        return -1;
+    }
+}
+
+} // namespace zodiac
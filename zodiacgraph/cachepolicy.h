@@ -0,0 +1,256 @@
+//
+//    ZodiacGraph - A general-purpose, circular node graph UI module.
+//    Copyright (C) 2015  Clemens Sielaff
+//
+//    The MIT License
+//
+//    Permission is hereby granted, free of charge, to any person obtaining a copy of
+//    this software and associated documentation files (the "Software"), to deal in
+//    the Software without restriction, including without limitation the rights to
+//    use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+//    of the Software, and to permit persons to whom the Software is furnished to do so,
+//    subject to the following conditions:
+//
+//    The above copyright notice and this permission notice shall be included in all
+//    copies or substantial portions of the Software.
+//
+//    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//    SOFTWARE.
+//
+
+#ifndef ZODIAC_CACHEPOLICY_H
+#define ZODIAC_CACHEPOLICY_H
+
+///
+/// \file cachepolicy.h
+///
+/// \brief Contains the definition of the zodiac::CachePolicy class.
+///
+
+#include <QGraphicsItem>
+#include <QRectF>
+
+namespace zodiac {
+
+class Scene;
+
+///
+/// \brief Classes of cached items in the Scene, each of which has its own cache mode.
+///
+enum class CachedItem {
+    NODE        = 0,    ///< The core of a Node.
+    PLUG        = 1,    ///< A Plug.
+    PERIMETER   = 2,    ///< The Perimeter of a Node.
+    NODE_LABEL  = 3,    ///< The NodeLabel of a Node.
+    PLUG_LABEL  = 4,    ///< The PlugLabel of a Plug.
+    EDGE_LABEL  = 5,    ///< The EdgeLabel of an edge.
+};
+
+///
+/// \brief Chooses the QGraphicsItem::CacheMode of each class of items in a Scene to stay within a memory budget.
+///
+/// All item caches of a QGraphicsScene share the global QPixmapCache.
+/// With DeviceCoordinateCache, each visible item occupies a pixmap the size of the item on screen, so zooming into a
+/// large Scene can overflow the QPixmapCache, which then evicts and re-renders items with every frame.
+///
+/// The CachePolicy estimates the memory needed to cache the visible items of each class and assigns the cache modes
+/// by priority -- labels with their expensive text first, the simple Perimeter last:
+/// <ul>
+/// <li>DeviceCoordinateCache, if the pixmaps at the current zoom factor fit into the remaining budget.</li>
+/// <li>ItemCoordinateCache, if the View is zoomed out and the pixmaps at item resolution fit.</li>
+/// <li>NoCache otherwise.</li>
+/// </ul>
+///
+/// Node%s and Plug%s are not cached while the SpriteAtlas of the Scene is enabled, as they draw from shared sprites.
+///
+/// The policy is updated by the View, whenever an interaction has ended.
+/// It also counts how often the items of each class are rendered, compared to how often they are drawn.
+///
+class CachePolicy
+{
+
+public: // methods
+
+    ///
+    /// \brief Constructor.
+    ///
+    /// \param [in] scene   Scene whose items are managed by this policy.
+    ///
+    explicit CachePolicy(Scene* scene);
+
+    ///
+    /// \brief The cache mode currently assigned to a class of items.
+    ///
+    /// \param [in] item    Class of items.
+    ///
+    /// \return             Cache mode of the items.
+    ///
+    inline QGraphicsItem::CacheMode getCacheMode(CachedItem item) const {return m_cacheModes[int(item)];}
+
+    ///
+    /// \brief Re-evaluates the cache mode of each class of items and applies changes to all items in the Scene.
+    ///
+    /// \param [in] zoomFactor  Current zoom factor of the View.
+    /// \param [in] visibleRect Visible area of the View in scene coordinates.
+    ///
+    void update(qreal zoomFactor, const QRectF& visibleRect);
+
+    ///
+    /// \brief Re-evaluates the cache modes with the zoom factor and visible area of the last update.
+    ///
+    /// Is called by the Scene, when the SpriteAtlas is enabled or disabled.
+    ///
+    void refresh();
+
+    ///
+    /// \brief Applies the current cache mode of its class to a single item.
+    ///
+    /// Does nothing for items that are not managed by the policy.
+    ///
+    /// \param [in] item    Item to apply the cache mode to.
+    ///
+    void apply(QGraphicsItem* item) const;
+
+    ///
+    /// \brief The memory budget for the item caches of the Scene.
+    ///
+    /// \return Memory budget in kilobytes.
+    ///
+    inline int getMemoryBudget() const {return m_memoryBudget;}
+
+    ///
+    /// \brief Sets a new memory budget for the item caches of the Scene.
+    ///
+    /// Raises the limit of the QPixmapCache, if it is lower than the budget.
+    /// Takes effect with the next update().
+    ///
+    /// \param [in] kilobytes   New memory budget in kilobytes.
+    ///
+    void setMemoryBudget(int kilobytes);
+
+    ///
+    /// \brief Counts a render of an item into its cache (or onto the screen, if it is not cached).
+    ///
+    /// Is called by the managed items in their paint method.
+    /// Like the draws, renders are only counted while statistics are enabled.
+    ///
+    /// \param [in] item    Class of the rendered item.
+    ///
+    inline void recordRender(CachedItem item) {if(m_areStatisticsEnabled){++m_renderCounts[int(item)];}}
+
+    ///
+    /// \brief Counts the items of each class that are drawn in a frame.
+    ///
+    /// Only has an effect, if statistics are enabled, as this queries the items in the visible area.
+    ///
+    /// \param [in] visibleRect Area drawn in the frame in scene coordinates.
+    ///
+    void recordFrame(const QRectF& visibleRect);
+
+    ///
+    /// \brief The fraction of draws of a class of items that were served from the cache.
+    ///
+    /// \param [in] item    Class of items.
+    ///
+    /// \return             Hit rate [0 -> 1] of the class or 0, if no draws have been recorded.
+    ///
+    qreal getHitRate(CachedItem item) const;
+
+    ///
+    /// \brief The fraction of draws of a class of items that required the item to be rendered.
+    ///
+    /// \param [in] item    Class of items.
+    ///
+    /// \return             Miss rate [0 -> 1] of the class or 0, if no draws have been recorded.
+    ///
+    qreal getMissRate(CachedItem item) const;
+
+    ///
+    /// \brief Resets all recorded renders and draws.
+    ///
+    void resetStatistics();
+
+    ///
+    /// \brief Whether the draws per frame are recorded to calculate the hit and miss rates.
+    ///
+    /// \return <i>true</i> if statistics are enabled -- <i>false</i> otherwise.
+    ///
+    inline bool areStatisticsEnabled() const {return m_areStatisticsEnabled;}
+
+    ///
+    /// \brief Enables or disables recording the draws per frame.
+    ///
+    /// \param [in] enabled <i>true</i> to enable statistics -- <i>false</i> to disable them.
+    ///
+    inline void setStatisticsEnabled(bool enabled) {m_areStatisticsEnabled=enabled;}
+
+public: // static methods
+
+    ///
+    /// \brief Returns the class of a managed item.
+    ///
+    /// \param [in] item    Item to classify.
+    ///
+    /// \return             Index of the CachedItem class of the item or -1, if it is not managed by the policy.
+    ///
+    static int getClassOf(const QGraphicsItem* item);
+
+private: // static members
+
+    ///
+    /// \brief Number of CachedItem classes.
+    ///
+    static const int s_classCount = 6;
+
+private: // members
+
+    ///
+    /// \brief Scene whose items are managed by this policy.
+    ///
+    Scene* m_scene;
+
+    ///
+    /// \brief Memory budget for the item caches in kilobytes.
+    ///
+    int m_memoryBudget;
+
+    ///
+    /// \brief Whether the draws per frame are recorded.
+    ///
+    bool m_areStatisticsEnabled;
+
+    ///
+    /// \brief Zoom factor of the last update.
+    ///
+    qreal m_zoomFactor;
+
+    ///
+    /// \brief Visible area of the last update.
+    ///
+    QRectF m_visibleRect;
+
+    ///
+    /// \brief Current cache mode of each CachedItem class.
+    ///
+    QGraphicsItem::CacheMode m_cacheModes[s_classCount];
+
+    ///
+    /// \brief Number of renders of each CachedItem class since the last reset.
+    ///
+    quint64 m_renderCounts[s_classCount];
+
+    ///
+    /// \brief Number of draws of each CachedItem class since the last reset.
+    ///
+    quint64 m_drawCounts[s_classCount];
+
+};
+
+} // namespace zodiac
+
+#endif // ZODIAC_CACHEPOLICY_H
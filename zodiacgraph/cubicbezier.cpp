@@ -0,0 +1,152 @@
+#include "cubicbezier.h"
+
+#include <QtMath>
+
+#include <cfloat>                       // for DBL_MAX
+
+#include "utils.h"
+
+static void addExtremaOf(qreal p0, qreal p1, qreal p2, qreal p3, qreal* roots, int& rootCount);
+
+namespace zodiac {
+
+CubicBezier::CubicBezier(const QPointF& start, const QPointF& ctrl1, const QPointF& ctrl2, const QPointF& end)
+    : m_points{start, ctrl1, ctrl2, end}
+    , m_bounds(QRectF())
+{
+    // accumulate the arclength table
+    m_lengths[0] = 0.;
+    QPointF lastPoint = start;
+    for(int i = 1; i <= SAMPLE_COUNT; ++i){
+        QPointF point = pointAt(qreal(i)/SAMPLE_COUNT);
+        QPointF chord = point-lastPoint;
+        m_lengths[i] = m_lengths[i-1] + qSqrt(QPointF::dotProduct(chord, chord));
+        lastPoint = point;
+    }
+
+    // the bounds are defined by the end points and the extrema of the curve in x and y
+    qreal roots[4];
+    int rootCount = 0;
+    addExtremaOf(start.x(), ctrl1.x(), ctrl2.x(), end.x(), roots, rootCount);
+    addExtremaOf(start.y(), ctrl1.y(), ctrl2.y(), end.y(), roots, rootCount);
+    qreal left = qMin(start.x(), end.x());
+    qreal right = qMax(start.x(), end.x());
+    qreal top = qMin(start.y(), end.y());
+    qreal bottom = qMax(start.y(), end.y());
+    for(int i = 0; i < rootCount; ++i){
+        QPointF extremum = pointAt(roots[i]);
+        left = qMin(left, extremum.x());
+        right = qMax(right, extremum.x());
+        top = qMin(top, extremum.y());
+        bottom = qMax(bottom, extremum.y());
+    }
+    m_bounds = QRectF(QPointF(left, top), QPointF(right, bottom));
+}
+
+QPointF CubicBezier::pointAt(qreal t) const
+{
+    qreal u = 1.-t;
+    return (m_points[0]*(u*u*u)) + (m_points[1]*(3.*u*u*t)) + (m_points[2]*(3.*u*t*t)) + (m_points[3]*(t*t*t));
+}
+
+QPointF CubicBezier::tangentAt(qreal t) const
+{
+    qreal u = 1.-t;
+    return ((m_points[1]-m_points[0])*(3.*u*u)) + ((m_points[2]-m_points[1])*(6.*u*t))
+            + ((m_points[3]-m_points[2])*(3.*t*t));
+}
+
+qreal CubicBezier::parameterAtPercent(qreal fraction) const
+{
+    // find the chord containing the requested length
+    qreal length = qBound(0., fraction, 1.)*getLength();
+    int index = 1;
+    while((index < SAMPLE_COUNT) && (m_lengths[index] < length)){
+        ++index;
+    }
+
+    // interpolate the parameter within the chord
+    qreal chordLength = m_lengths[index]-m_lengths[index-1];
+    qreal chordFraction = qFuzzyIsNull(chordLength) ? 0. : (length-m_lengths[index-1])/chordLength;
+    return (qreal(index-1)+chordFraction)/SAMPLE_COUNT;
+}
+
+QPolygonF CubicBezier::flatten(qreal tolerance) const
+{
+    static const int MAX_SEGMENTS = 256;
+
+    // the number of segments is derived from the maximal second difference of the control polygon
+    QPointF firstDifference = m_points[0]-(m_points[1]*2.)+m_points[2];
+    QPointF secondDifference = m_points[1]-(m_points[2]*2.)+m_points[3];
+    qreal maxDifference = qSqrt(qMax(QPointF::dotProduct(firstDifference, firstDifference),
+                                     QPointF::dotProduct(secondDifference, secondDifference)));
+    int segmentCount = MAX_SEGMENTS;
+    if(tolerance>0.){
+        segmentCount = qBound(1, qCeil(qSqrt(0.75*maxDifference/tolerance)), MAX_SEGMENTS);
+    }
+
+    // sample the spline
+    QPolygonF polyline;
+    polyline.reserve(segmentCount+1);
+    polyline.append(m_points[0]);
+    for(int i = 1; i < segmentCount; ++i){
+        polyline.append(pointAt(qreal(i)/segmentCount));
+    }
+    polyline.append(m_points[3]);
+    return polyline;
+}
+
+qreal CubicBezier::getDistanceTo(const QPointF& point, const QPolygonF& polyline)
+{
+    qreal distance = DBL_MAX;
+    for(int i = 1; i < polyline.size(); ++i){
+        distance = qMin(distance, distanceToSegment(point, polyline.at(i-1), polyline.at(i)));
+    }
+    return distance;
+}
+
+} // namespace zodiac
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// HELPER
+//
+
+///
+/// \brief Finds the parameters of the extrema of a one-dimensional cubic bezier curve within ]0, 1[.
+///
+/// \param p0           Start value of the curve.
+/// \param p1           First control value of the curve.
+/// \param p2           Second control value of the curve.
+/// \param p3           End value of the curve.
+/// \param roots        [out] Array to append the found parameters to.
+/// \param rootCount    [in/out] Number of parameters in the array, is increased for each found extremum.
+///
+static void addExtremaOf(qreal p0, qreal p1, qreal p2, qreal p3, qreal* roots, int& rootCount)
+{
+    // the derivative of the curve is a quadratic polynomial a*t^2 + b*t + c
+    qreal a = (p1-p0) - 2.*(p2-p1) + (p3-p2);
+    qreal b = 2.*((p2-p1) - (p1-p0));
+    qreal c = p1-p0;
+
+    qreal candidates[2];
+    int candidateCount = 0;
+    if(qFuzzyIsNull(a)){
+        if(!qFuzzyIsNull(b)){
+            candidates[candidateCount++] = -c/b;
+        }
+    } else {
+        qreal discriminant = b*b - 4.*a*c;
+        if(discriminant >= 0.){
+            qreal root = qSqrt(discriminant);
+            candidates[candidateCount++] = (-b+root)/(2.*a);
+            candidates[candidateCount++] = (-b-root)/(2.*a);
+        }
+    }
+
+    for(int i = 0; i < candidateCount; ++i){
+        if((candidates[i] > 0.) && (candidates[i] < 1.)){
+            roots[rootCount++] = candidates[i];
+        }
+    }
+}
@@ -0,0 +1,162 @@
+//
+//    ZodiacGraph - A general-purpose, circular node graph UI module.
+//    Copyright (C) 2015  Clemens Sielaff
+//
+//    The MIT License
+//
+//    Permission is hereby granted, free of charge, to any person obtaining a copy of
+//    this software and associated documentation files (the "Software"), to deal in
+//    the Software without restriction, including without limitation the rights to
+//    use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+//    of the Software, and to permit persons to whom the Software is furnished to do so,
+//    subject to the following conditions:
+//
+//    The above copyright notice and this permission notice shall be included in all
+//    copies or substantial portions of the Software.
+//
+//    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//    SOFTWARE.
+//
+
+#ifndef ZODIAC_CUBICBEZIER_H
+#define ZODIAC_CUBICBEZIER_H
+
+///
+/// \file cubicbezier.h
+///
+/// \brief Contains the definition of the zodiac::CubicBezier class.
+///
+
+#include <QPointF>
+#include <QPolygonF>
+#include <QRectF>
+
+namespace zodiac {
+
+///
+/// \brief Geometry of a single cubic bezier spline.
+///
+/// Offers analytical evaluation of the spline by parameter and by arclength, its exact bounding rectangle and a
+/// flattened polyline approximation, as well as the distance of a point to such a polyline.
+///
+/// QPainterPath offers most of the same functionality, but walks its elements and recalculates the arclength of the
+/// spline for every call to QPainterPath::pointAtPercent().
+/// A CubicBezier calculates its arclength table and bounds once on construction and is then cheap to query.
+///
+class CubicBezier
+{
+
+public: // methods
+
+    ///
+    /// \brief Constructor.
+    ///
+    /// \param [in] start   Start point of the spline.
+    /// \param [in] ctrl1   First control point of the spline.
+    /// \param [in] ctrl2   Second control point of the spline.
+    /// \param [in] end     End point of the spline.
+    ///
+    CubicBezier(const QPointF& start = QPointF(), const QPointF& ctrl1 = QPointF(),
+                const QPointF& ctrl2 = QPointF(), const QPointF& end = QPointF());
+
+    ///
+    /// \brief Evaluates the spline at a given parameter.
+    ///
+    /// \param [in] t   Parameter [0 -> 1] along the spline.
+    ///
+    /// \return         Point on the spline.
+    ///
+    QPointF pointAt(qreal t) const;
+
+    ///
+    /// \brief Evaluates the first derivative of the spline at a given parameter.
+    ///
+    /// \param [in] t   Parameter [0 -> 1] along the spline.
+    ///
+    /// \return         Tangent of the spline, not normalized.
+    ///
+    QPointF tangentAt(qreal t) const;
+
+    ///
+    /// \brief Finds the parameter at a given fraction of the spline's arclength.
+    ///
+    /// The arclength is approximated by a fixed number of chords and interpolated linearly in between.
+    ///
+    /// \param [in] fraction    Fraction [0 -> 1] of the arclength.
+    ///
+    /// \return                 Parameter [0 -> 1] of the spline.
+    ///
+    qreal parameterAtPercent(qreal fraction) const;
+
+    ///
+    /// \brief The approximate arclength of the spline.
+    ///
+    /// \return Arclength of the spline.
+    ///
+    inline qreal getLength() const {return m_lengths[SAMPLE_COUNT];}
+
+    ///
+    /// \brief The exact bounding rectangle of the spline, calculated from the extrema of the curve.
+    ///
+    /// \return Bounding rectangle of the spline.
+    ///
+    inline const QRectF& getBoundingRect() const {return m_bounds;}
+
+    ///
+    /// \brief Approximates the spline with a polyline.
+    ///
+    /// The number of segments is calculated so that no point of the polyline is further away from the spline than the
+    /// given tolerance.
+    ///
+    /// \param [in] tolerance   Maximal distance of the polyline to the spline.
+    ///
+    /// \return                 Flattened spline.
+    ///
+    QPolygonF flatten(qreal tolerance) const;
+
+public: // static methods
+
+    ///
+    /// \brief Calculates the distance of a point to a polyline.
+    ///
+    /// \param [in] point       Point to calculate the distance for.
+    /// \param [in] polyline    Polyline to measure against.
+    ///
+    /// \return                 Distance of the point to the closest segment of the polyline.
+    ///
+    static qreal getDistanceTo(const QPointF& point, const QPolygonF& polyline);
+
+private: // static members
+
+    ///
+    /// \brief Number of chords used to approximate the arclength of the spline.
+    ///
+    static const int SAMPLE_COUNT = 16;
+
+private: // members
+
+    ///
+    /// \brief Start point, both control points and end point of the spline.
+    ///
+    QPointF m_points[4];
+
+    ///
+    /// \brief Accumulated arclength of the spline at each of the evenly spaced parameter samples.
+    ///
+    qreal m_lengths[SAMPLE_COUNT+1];
+
+    ///
+    /// \brief Exact bounding rectangle of the spline.
+    ///
+    QRectF m_bounds;
+
+};
+
+} // namespace zodiac
+
+#endif // ZODIAC_CUBICBEZIER_H
@@ -0,0 +1,172 @@
+#include "draglayer.h"
+
+#include <QGraphicsRectItem>
+
+#include "baseedge.h"
+#include "node.h"
+#include "plug.h"
+#include "plugedge.h"
+#include "scene.h"
+#include "straightedge.h"
+#include "utils.h"
+
+namespace zodiac {
+
+int DragLayer::s_unindexedThreshold = 1000;
+
+DragLayer::DragLayer(Scene* scene)
+    : QGraphicsItem(nullptr)
+    , m_scene(scene)
+    , m_nodes(QSet<Node*>())
+    , m_edgeLayer(nullptr)
+    , m_innerEdges(QList<BaseEdge*>())
+    , m_outerPlugEdges(QSet<PlugEdge*>())
+    , m_outerStraightEdges(QSet<StraightEdge*>())
+    , m_previousIndexMethod(QGraphicsScene::BspTreeIndex)
+    , m_isActive(false)
+{
+    setFlag(ItemHasNoContents);
+    setZValue(zStack::DRAG_LAYER);
+    m_scene->addItem(this);
+}
+
+void DragLayer::collect(Node* grabbedNode)
+{
+    // finish a previous drag that was never released
+    if(m_isActive){
+        commit();
+    }
+
+    // collect all selected nodes, including the grabbed one
+    m_nodes = m_scene->getSelectedNodes();
+    m_nodes.insert(grabbedNode);
+
+    // sort the edges into those moving with the layer and those crossing its border
+    QSet<BaseEdge*> innerEdges;
+    for(Node* node : m_nodes){
+        for(Plug* plug : node->getPlugs()){
+            for(PlugEdge* edge : plug->getEdges()){
+                Plug* otherPlug = (edge->getStartPlug()==plug) ? edge->getEndPlug() : edge->getStartPlug();
+                if(m_nodes.contains(otherPlug->getNode())){
+                    innerEdges.insert(edge);
+                } else {
+                    m_outerPlugEdges.insert(edge);
+                }
+            }
+        }
+        for(StraightEdge* edge : node->getStraightEdges()){
+            Node* otherNode = (edge->getFromNode()==node) ? edge->getToNode() : edge->getFromNode();
+            if(m_nodes.contains(otherNode)){
+                innerEdges.insert(edge);
+            } else {
+                m_outerStraightEdges.insert(edge);
+            }
+        }
+    }
+    m_innerEdges = innerEdges.toList();
+
+    // large drags are faster without an index that has to follow every move
+    m_previousIndexMethod = m_scene->itemIndexMethod();
+    if((m_previousIndexMethod!=QGraphicsScene::NoIndex)
+            && (m_nodes.size()+m_innerEdges.size() >= s_unindexedThreshold)){
+        m_scene->setItemIndexMethod(QGraphicsScene::NoIndex);
+    }
+
+    // move the items into the layer without changing their scene position,
+    // the inner edges are moved by a second layer that stays behind all Nodes
+    setPos(QPointF());
+    for(Node* node : m_nodes){
+        node->setParentItem(this);
+    }
+    if(!m_innerEdges.isEmpty()){
+        m_edgeLayer = new QGraphicsRectItem();
+        m_edgeLayer->setFlag(ItemHasNoContents);
+        m_edgeLayer->setZValue(zStack::EDGE);
+        m_scene->addItem(m_edgeLayer);
+        for(BaseEdge* edge : m_innerEdges){
+            edge->discardLabel(); // the free-floating label would not follow the edge
+            edge->setParentItem(m_edgeLayer);
+        }
+    }
+
+    m_isActive = true;
+}
+
+void DragLayer::setOffset(const QPointF& offset)
+{
+    if(!m_isActive || (offset==pos())){
+        return;
+    }
+
+    // move the layers with everything inside them
+    setPos(offset);
+    if(m_edgeLayer){
+        m_edgeLayer->setPos(offset);
+    }
+
+    // only the edges crossing the border of the layer have to be recalculated
+    updateOuterEdges();
+}
+
+void DragLayer::commit()
+{
+    if(!m_isActive){
+        return;
+    }
+    m_isActive = false;
+
+    // move the items back into the scene at their new position,
+    // the inner edges keep their shape and are only translated
+    QPointF offset = pos();
+    for(Node* node : m_nodes){
+        node->setParentItem(nullptr);
+        node->setPos(node->pos()+offset);
+    }
+    for(BaseEdge* edge : m_innerEdges){
+        edge->setParentItem(nullptr);
+        edge->setPos(edge->pos()+offset);
+    }
+    delete m_edgeLayer;
+    m_edgeLayer = nullptr;
+    setPos(QPointF());
+
+    // rebuild the index once, if it was disabled
+    if(m_scene->itemIndexMethod()!=m_previousIndexMethod){
+        m_scene->setItemIndexMethod(m_previousIndexMethod);
+    }
+
+    // the edge index registers the edges in scene coordinates, the QGraphicsScene follows the translation by itself
+    if(m_scene->getEdgeIndexMethod()==EdgeIndexMethod::EDGE_GRID){
+        for(BaseEdge* edge : m_innerEdges){
+            edge->updateBounds();
+        }
+    }
+
+    // the outer edges have already been recalculated for the last offset and return early, unless there was none
+    updateOuterEdges();
+
+    m_nodes.clear();
+    m_innerEdges.clear();
+    m_outerPlugEdges.clear();
+    m_outerStraightEdges.clear();
+}
+
+void DragLayer::updateOuterEdges()
+{
+    m_scene->getEdgeGeometryBuffer().addEdges(m_outerPlugEdges);
+    m_scene->getEdgeGeometryBuffer().update();
+    for(StraightEdge* edge : m_outerStraightEdges){
+        edge->nodePositionHasChanged();
+    }
+}
+
+QRectF DragLayer::boundingRect() const
+{
+    return QRectF();
+}
+
+void DragLayer::paint(QPainter*, const QStyleOptionGraphicsItem*, QWidget*)
+{
+}
+
+} // namespace zodiac
@@ -0,0 +1,200 @@
+//
+//    ZodiacGraph - A general-purpose, circular node graph UI module.
+//    Copyright (C) 2015  Clemens Sielaff
+//
+//    The MIT License
+//
+//    Permission is hereby granted, free of charge, to any person obtaining a copy of
+//    this software and associated documentation files (the "Software"), to deal in
+//    the Software without restriction, including without limitation the rights to
+//    use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+//    of the Software, and to permit persons to whom the Software is furnished to do so,
+//    subject to the following conditions:
+//
+//    The above copyright notice and this permission notice shall be included in all
+//    copies or substantial portions of the Software.
+//
+//    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//    SOFTWARE.
+//
+
+#ifndef ZODIAC_DRAGLAYER_H
+#define ZODIAC_DRAGLAYER_H
+
+///
+/// \file draglayer.h
+///
+/// \brief Contains the definition of the zodiac::DragLayer class.
+///
+
+#include <QGraphicsItem>
+#include <QGraphicsScene>
+#include <QSet>
+
+class QGraphicsRectItem;
+
+namespace zodiac {
+
+class BaseEdge;
+class Node;
+class PlugEdge;
+class Scene;
+class StraightEdge;
+
+///
+/// \brief Invisible item that moves all selected Node%s as a single layer while the user is dragging them.
+///
+/// Instead of having each selected Node moved individually by Qt on every mouse move, the DragLayer temporarily
+/// becomes the parent of all dragged Node%s.
+/// The edges between them are moved by a second, empty layer item that is stacked with all other edges, so they stay
+/// behind the Node%s.
+/// Both layers move rigidly, so only the edges crossing the border of the selection have to be recalculated during the
+/// gesture.
+/// When the drag is finished, the final positions are committed back to the Node%s and the inner edges are translated
+/// by the same offset, without recalculating their shape.
+///
+/// If the dragged selection is large, the Scene's item index is disabled for the duration of the drag and rebuilt
+/// once on release.
+///
+class DragLayer : public QGraphicsItem
+{
+
+public: // methods
+
+    ///
+    /// \brief Constructor.
+    ///
+    /// \param [in] scene   Scene containing this DragLayer.
+    ///
+    explicit DragLayer(Scene* scene);
+
+    ///
+    /// \brief Collects all selected Node%s and their edges into the DragLayer at the start of a drag.
+    ///
+    /// If the layer is already active, the previous drag is committed first.
+    ///
+    /// \param [in] grabbedNode The Node grabbed by the mouse, is always part of the drag even if not selected.
+    ///
+    void collect(Node* grabbedNode);
+
+    ///
+    /// \brief Moves the collected Node%s by the given offset relative to their positions at the start of the drag.
+    ///
+    /// Does nothing if the layer is not active.
+    ///
+    /// \param [in] offset  Offset in scene coordinates.
+    ///
+    void setOffset(const QPointF& offset);
+
+    ///
+    /// \brief Moves all collected items back into the Scene at their new position and deactivates the layer.
+    ///
+    /// Does nothing if the layer is not active.
+    ///
+    void commit();
+
+    ///
+    /// \brief Checks if the DragLayer currently holds dragged Node%s.
+    ///
+    /// \return <i>true</i> if a drag is in progress -- <i>false</i> otherwise.
+    ///
+    inline bool isActive() const {return m_isActive;}
+
+public: // static methods
+
+    ///
+    /// \brief Number of dragged items from which on the Scene's item index is disabled during a drag.
+    ///
+    /// \return Minimal item count for an unindexed drag.
+    ///
+    static inline int getUnindexedThreshold() {return s_unindexedThreshold;}
+
+    ///
+    /// \brief Sets the number of dragged items from which on the Scene's item index is disabled during a drag.
+    ///
+    /// \param [in] threshold   New minimal item count for an unindexed drag.
+    ///
+    static inline void setUnindexedThreshold(int threshold) {s_unindexedThreshold=qMax(0, threshold);}
+
+protected: // methods
+
+    ///
+    /// \brief The DragLayer has no contents of its own.
+    ///
+    /// \return An empty rectangle.
+    ///
+    QRectF boundingRect() const;
+
+    ///
+    /// \brief Does nothing, as the DragLayer has no contents of its own.
+    ///
+    void paint(QPainter*, const QStyleOptionGraphicsItem*, QWidget*);
+
+private: // methods
+
+    ///
+    /// \brief Recalculates the edges between a dragged and a static Node.
+    ///
+    void updateOuterEdges();
+
+private: // members
+
+    ///
+    /// \brief Scene containing this DragLayer.
+    ///
+    Scene* m_scene;
+
+    ///
+    /// \brief All Node%s moved with the layer.
+    ///
+    QSet<Node*> m_nodes;
+
+    ///
+    /// \brief Empty item at the z-value of the edges, parent of the inner edges during a drag.
+    ///
+    /// Only exists during a drag with inner edges.
+    ///
+    QGraphicsRectItem* m_edgeLayer;
+
+    ///
+    /// \brief Edges between two dragged Node%s, moved with the edge layer.
+    ///
+    QList<BaseEdge*> m_innerEdges;
+
+    ///
+    /// \brief PlugEdge%s between a dragged and a static Node, recalculated on every move.
+    ///
+    QSet<PlugEdge*> m_outerPlugEdges;
+
+    ///
+    /// \brief StraightEdge%s between a dragged and a static Node, recalculated on every move.
+    ///
+    QSet<StraightEdge*> m_outerStraightEdges;
+
+    ///
+    /// \brief Item index method of the Scene before it was disabled for the drag.
+    ///
+    QGraphicsScene::ItemIndexMethod m_previousIndexMethod;
+
+    ///
+    /// \brief Whether a drag is in progress.
+    ///
+    bool m_isActive;
+
+private: // static members
+
+    ///
+    /// \brief Number of dragged items from which on the Scene's item index is disabled during a drag.
+    ///
+    static int s_unindexedThreshold;
+
+};
+
+} // namespace zodiac
+
+#endif // ZODIAC_DRAGLAYER_H
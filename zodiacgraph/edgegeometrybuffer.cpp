@@ -0,0 +1,119 @@
+#include "edgegeometrybuffer.h"
+
+#include "plug.h"
+#include "plugedge.h"
+
+namespace zodiac {
+
+EdgeGeometryBuffer::EdgeGeometryBuffer()
+    : m_edges(QVector<PlugEdge*>())
+    , m_startX(QVector<qreal>())
+    , m_startY(QVector<qreal>())
+    , m_endX(QVector<qreal>())
+    , m_endY(QVector<qreal>())
+    , m_startNormalX(QVector<qreal>())
+    , m_startNormalY(QVector<qreal>())
+    , m_endNormalX(QVector<qreal>())
+    , m_endNormalY(QVector<qreal>())
+    , m_ctrl1X(QVector<qreal>())
+    , m_ctrl1Y(QVector<qreal>())
+    , m_ctrl2X(QVector<qreal>())
+    , m_ctrl2Y(QVector<qreal>())
+{
+}
+
+void EdgeGeometryBuffer::addEdge(PlugEdge* edge)
+{
+    edge->updateBentState();
+
+    // skip edges whose end points have not changed
+    Plug* startPlug = edge->getStartPlug();
+    Plug* endPlug = edge->getEndPlug();
+    QPointF startPoint = edge->mapFromScene(startPlug->scenePos());
+    QPointF endPoint = edge->mapFromScene(endPlug->scenePos());
+    if((startPoint==edge->m_startPoint)&&(endPoint==edge->m_endPoint)){
+        return;
+    }
+
+    // gather the input of the control point calculation
+    m_edges.append(edge);
+    m_startX.append(startPoint.x());
+    m_startY.append(startPoint.y());
+    m_endX.append(endPoint.x());
+    m_endY.append(endPoint.y());
+    QPointF startNormal = startPlug->getNormal().toPointF() * PlugEdge::getExpansionFactorOf(startPlug);
+    QPointF endNormal = endPlug->getNormal().toPointF() * PlugEdge::getExpansionFactorOf(endPlug);
+    m_startNormalX.append(startNormal.x());
+    m_startNormalY.append(startNormal.y());
+    m_endNormalX.append(endNormal.x());
+    m_endNormalY.append(endNormal.y());
+}
+
+void EdgeGeometryBuffer::addEdges(const QSet<PlugEdge*>& edges)
+{
+    for(PlugEdge* edge : edges){
+        addEdge(edge);
+    }
+}
+
+void EdgeGeometryBuffer::update()
+{
+    // return early, if there is nothing to do
+    const int count = m_edges.size();
+    if(count==0){
+        return;
+    }
+
+    // make room for the output
+    m_ctrl1X.resize(count);
+    m_ctrl1Y.resize(count);
+    m_ctrl2X.resize(count);
+    m_ctrl2Y.resize(count);
+
+    // calculate all control points in one loop over plain arrays (see BezierEdge::getCtrlPointFor for details)
+    const qreal maxCtrlDistance = PlugEdge::getMaxCtrlDistance();
+    const qreal expansionFactor = PlugEdge::getCtrlExpansionFactor();
+    const qreal* startX = m_startX.constData();
+    const qreal* startY = m_startY.constData();
+    const qreal* endX = m_endX.constData();
+    const qreal* endY = m_endY.constData();
+    const qreal* startNormalX = m_startNormalX.constData();
+    const qreal* startNormalY = m_startNormalY.constData();
+    const qreal* endNormalX = m_endNormalX.constData();
+    const qreal* endNormalY = m_endNormalY.constData();
+    qreal* ctrl1X = m_ctrl1X.data();
+    qreal* ctrl1Y = m_ctrl1Y.data();
+    qreal* ctrl2X = m_ctrl2X.data();
+    qreal* ctrl2Y = m_ctrl2Y.data();
+    for(int i = 0; i < count; ++i){
+        qreal manhattanLength = qAbs(endX[i]-startX[i]) + qAbs(endY[i]-startY[i]);
+        qreal ctrlDistance = qMin(maxCtrlDistance, manhattanLength*expansionFactor);
+        ctrl1X[i] = startX[i] + (startNormalX[i]*ctrlDistance);
+        ctrl1Y[i] = startY[i] + (startNormalY[i]*ctrlDistance);
+        ctrl2X[i] = endX[i] + (endNormalX[i]*ctrlDistance);
+        ctrl2Y[i] = endY[i] + (endNormalY[i]*ctrlDistance);
+    }
+
+    // hand the results back to the edges
+    for(int i = 0; i < count; ++i){
+        PlugEdge* edge = m_edges.at(i);
+        edge->m_startPoint = QPointF(startX[i], startY[i]);
+        edge->m_ctrlPoint1 = QPointF(ctrl1X[i], ctrl1Y[i]);
+        edge->m_ctrlPoint2 = QPointF(ctrl2X[i], ctrl2Y[i]);
+        edge->m_endPoint = QPointF(endX[i], endY[i]);
+        edge->updateShape();
+    }
+
+    // clear the batch but keep the memory for the next one
+    m_edges.resize(0);
+    m_startX.resize(0);
+    m_startY.resize(0);
+    m_endX.resize(0);
+    m_endY.resize(0);
+    m_startNormalX.resize(0);
+    m_startNormalY.resize(0);
+    m_endNormalX.resize(0);
+    m_endNormalY.resize(0);
+}
+
+} // namespace zodiac
@@ -0,0 +1,166 @@
+//
+//    ZodiacGraph - A general-purpose, circular node graph UI module.
+//    Copyright (C) 2015  Clemens Sielaff
+//
+//    The MIT License
+//
+//    Permission is hereby granted, free of charge, to any person obtaining a copy of
+//    this software and associated documentation files (the "Software"), to deal in
+//    the Software without restriction, including without limitation the rights to
+//    use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+//    of the Software, and to permit persons to whom the Software is furnished to do so,
+//    subject to the following conditions:
+//
+//    The above copyright notice and this permission notice shall be included in all
+//    copies or substantial portions of the Software.
+//
+//    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//    SOFTWARE.
+//
+
+#ifndef ZODIAC_EDGEGEOMETRYBUFFER_H
+#define ZODIAC_EDGEGEOMETRYBUFFER_H
+
+///
+/// \file edgegeometrybuffer.h
+///
+/// \brief Contains the definition of the zodiac::EdgeGeometryBuffer class.
+///
+
+#include <QSet>
+#include <QVector>
+
+namespace zodiac {
+
+class PlugEdge;
+
+///
+/// \brief Recalculates the geometry of many PlugEdge%s in a single batch.
+///
+/// When a Node with many connections moves or expands, all of its PlugEdge%s need new control points.
+/// Instead of letting every edge calculate its own points, the EdgeGeometryBuffer collects the input of all edges in
+/// a structure of arrays (one contiguous array per coordinate) and calculates all control points in a single, tight
+/// loop that the compiler is able to vectorize.
+/// Afterwards, the results are handed back to the edges, which only have to update their shape.
+///
+/// Usage:
+/// \code
+/// EdgeGeometryBuffer& buffer = scene->getEdgeGeometryBuffer();
+/// for(Plug* plug : plugs){
+///     buffer.addEdges(plug->getEdges());
+/// }
+/// buffer.update();
+/// \endcode
+///
+/// The Scene owns a single EdgeGeometryBuffer that is reused for all batches, so its arrays only need to grow once.
+/// Since QGraphicsItem%s may only be modified in the GUI thread, there is no multi-threading.
+///
+class EdgeGeometryBuffer
+{
+
+public: // methods
+
+    ///
+    /// \brief Constructor.
+    ///
+    EdgeGeometryBuffer();
+
+    ///
+    /// \brief Adds a PlugEdge to the current batch.
+    ///
+    /// Reads the current positions of the edge's Plug%s, so make sure that they are up-to-date before calling this.
+    /// Edges whose end points have not changed are not added at all.
+    ///
+    /// \param [in] edge    PlugEdge to update.
+    ///
+    void addEdge(PlugEdge* edge);
+
+    ///
+    /// \brief Adds multiple PlugEdge%s to the current batch.
+    ///
+    /// \param [in] edges   PlugEdge%s to update.
+    ///
+    void addEdges(const QSet<PlugEdge*>& edges);
+
+    ///
+    /// \brief Calculates the geometry of all PlugEdge%s in the current batch, updates them and clears the batch.
+    ///
+    void update();
+
+private: // members
+
+    ///
+    /// \brief PlugEdge%s in the current batch.
+    ///
+    QVector<PlugEdge*> m_edges;
+
+    ///
+    /// \brief Start point x-coordinates.
+    ///
+    QVector<qreal> m_startX;
+
+    ///
+    /// \brief Start point y-coordinates.
+    ///
+    QVector<qreal> m_startY;
+
+    ///
+    /// \brief End point x-coordinates.
+    ///
+    QVector<qreal> m_endX;
+
+    ///
+    /// \brief End point y-coordinates.
+    ///
+    QVector<qreal> m_endY;
+
+    ///
+    /// \brief Start Plug normal x-coordinates, multiplied with the expansion factor of the start Node.
+    ///
+    QVector<qreal> m_startNormalX;
+
+    ///
+    /// \brief Start Plug normal y-coordinates, multiplied with the expansion factor of the start Node.
+    ///
+    QVector<qreal> m_startNormalY;
+
+    ///
+    /// \brief End Plug normal x-coordinates, multiplied with the expansion factor of the end Node.
+    ///
+    QVector<qreal> m_endNormalX;
+
+    ///
+    /// \brief End Plug normal y-coordinates, multiplied with the expansion factor of the end Node.
+    ///
+    QVector<qreal> m_endNormalY;
+
+    ///
+    /// \brief First control point x-coordinates, output of update().
+    ///
+    QVector<qreal> m_ctrl1X;
+
+    ///
+    /// \brief First control point y-coordinates, output of update().
+    ///
+    QVector<qreal> m_ctrl1Y;
+
+    ///
+    /// \brief Second control point x-coordinates, output of update().
+    ///
+    QVector<qreal> m_ctrl2X;
+
+    ///
+    /// \brief Second control point y-coordinates, output of update().
+    ///
+    QVector<qreal> m_ctrl2Y;
+
+};
+
+} // namespace zodiac
+
+#endif // ZODIAC_EDGEGEOMETRYBUFFER_H
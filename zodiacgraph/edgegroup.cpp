@@ -20,6 +20,7 @@ EdgeGroup::EdgeGroup(Scene* scene,
     , m_toNode(toNode)
     , m_pair(pair)
     , m_edges(QSet<PlugEdge*>())
+    , m_labelTextFactory(LabelTextFactory())
     , m_straightEdge(nullptr)
     , m_bentEdgesCount(0)
 {
@@ -35,6 +36,11 @@ EdgeGroup::~EdgeGroup()
 {
     // As EdgeGroups are always deleted before the rest of the QGraphicsView, this also work on shutdown
 
+    // a released edge is deleted together with all other items of the scene
+    if(!m_straightEdge){
+        return;
+    }
+
     m_straightEdge->getFromNode()->removeStraightEdge(m_straightEdge);
     m_straightEdge->getToNode()->removeStraightEdge(m_straightEdge);
 
@@ -54,6 +60,7 @@ void EdgeGroup::addEdge(PlugEdge* edge)
     }
 #endif
     m_edges.insert(edge);
+    m_labelTextFactory.addEdge(edge);
 
     // update the labels
     m_straightEdge->updateLabel();
@@ -70,6 +77,7 @@ void EdgeGroup::removeEdge(PlugEdge* edge)
     }
 #endif
     m_edges.remove(edge);
+    m_labelTextFactory.removeEdge(edge);
 
     // if the edge to be removed is the last one in the group, it might be 'unbent'
     // to avoid confusion, temporarily set the bent count to 1 before decreasing it again
@@ -106,11 +114,6 @@ void EdgeGroup::updateVisibility()
     }
 }
 
-uint EdgeGroup::getHash() const
-{
-    return getHashOf(m_fromNode, m_toNode);
-}
-
 bool EdgeGroup::isVisible() const
 {
     return m_straightEdge->isVisible();
@@ -121,9 +124,14 @@ void EdgeGroup::setVisibility(bool visibility)
     m_straightEdge->setVisible(visibility);
 }
 
-QString EdgeGroup::getLabelText()
+QString EdgeGroup::getLabelText(int page)
 {
-    return LabelTextFactory(m_edges).produceLabel();
+    return m_labelTextFactory.produceLabel(0, page);
+}
+
+int EdgeGroup::getLabelPageCount()
+{
+    return m_labelTextFactory.getPageCount();
 }
 
 void EdgeGroup::updateLabelText()
@@ -132,6 +140,12 @@ void EdgeGroup::updateLabelText()
     m_pair->updateLabel();
 }
 
+void EdgeGroup::renameEdge(PlugEdge* edge)
+{
+    m_labelTextFactory.updateEdge(edge);
+    updateLabelText();
+}
+
 void EdgeGroup::updateStyle()
 {
     m_straightEdge->updateStyle();
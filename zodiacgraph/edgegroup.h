@@ -34,10 +34,10 @@
 
 
 #include <QObject>
-#include <QPair>
 #include <QSet>
 
 #include "edgegroupinterface.h"
+#include "labeltextfactory.h"
 
 namespace zodiac {
 
@@ -79,6 +79,14 @@ public: // methods
     ///
     ~EdgeGroup();
 
+    ///
+    /// \brief Lets go of the StraightEdge of this group without removing it from the Scene.
+    ///
+    /// Is called by the Scene, when all of its items are deleted at once anyway.
+    /// Afterwards, the group can only be deleted.
+    ///
+    inline void releaseStraightEdge() {m_straightEdge = nullptr;}
+
     ///
     /// \brief Adds a new PlugEdge to this EdgeGroup.
     ///
@@ -121,11 +129,25 @@ public: // methods
     void updateVisibility();
 
     ///
-    /// \brief The hash of this EdgeGroup, as calculated by \ref zodiac::EdgeGroup::getHashOf() "getHashOf()".
+    /// \brief The Node from which the PlugEdge%s of this group originate.
+    ///
+    /// \return Start Node of this EdgeGroup.
+    ///
+    inline Node* getFromNode() const {return m_fromNode;}
+
+    ///
+    /// \brief The Node to which the PlugEdge%s of this group flow.
     ///
-    /// \return Hash of this EdgeGroup..
+    /// \return End Node of this EdgeGroup.
     ///
-    uint getHash() const;
+    inline Node* getToNode() const {return m_toNode;}
+
+    ///
+    /// \brief The StraightEdge drawn in place of the PlugEdge%s of this group, while they are all collapsed.
+    ///
+    /// \return StraightEdge of this EdgeGroup.
+    ///
+    inline StraightEdge* getStraightEdge() const {return m_straightEdge;}
 
     ///
     /// \brief <i>true</i> if the straight edge of this group is visible -- <i>false</i> otherwise.
@@ -166,39 +188,48 @@ public: // methods
     ///
     /// \brief Generates the label text for this EdgeGroup.
     ///
+    /// \param [in] page    Page of the label text, is clamped to the available pages.
+    ///
     /// \return Label text based on the PlugEdge%s contained in this group.
     ///
-    QString getLabelText();
+    QString getLabelText(int page);
 
     ///
-    /// \brief Updates the label text of the EdgeGroup's StraightEdge, as well as the StraightDouleEdge label.
+    /// \brief The number of pages of the label text for this EdgeGroup.
     ///
-    void updateLabelText();
+    /// \return Number of pages, at least 1.
+    ///
+    int getLabelPageCount();
 
     ///
-    /// \brief Applies style changes in the class' static members to this instance.
+    /// \brief The factory producing the label text of this EdgeGroup.
     ///
-    /// Is part of the scene-wide cascade of %updateStyle()-calls after a re-styling of the ZodiacGraph.
+    /// Is kept up-to-date with the PlugEdge%s in this group.
     ///
-    void updateStyle();
+    /// \return LabelTextFactory of this EdgeGroup.
+    ///
+    inline const LabelTextFactory& getLabelTextFactory() const {return m_labelTextFactory;}
 
-public: // static methods
+    ///
+    /// \brief Updates the label text of the EdgeGroup's StraightEdge, as well as the StraightDouleEdge label.
+    ///
+    void updateLabelText();
 
     ///
-    /// \brief Calculates a hash value based on two nodes.
+    /// \brief Updates the names of a PlugEdge in the label text, after one of its Plug%s or Node%s was renamed.
     ///
-    /// The order of nodes matters.
+    /// Only the line of the renamed PlugEdge is re-created.
     ///
-    /// \param [in] fromNode    Node from which the PlugEdge%s originate.
-    /// \param [in] toNode      Target Node of the PlugEdge%s in this group.
-    /// \param [in] seed        Seed value for the <a href="http://doc.qt.io/qt-5/qhash.html#qHash-33">qhash</a>
-    ///                         function.
+    /// \param [in] edge    Renamed PlugEdge of this group.
     ///
-    /// \return                 Hash value of an EdgeGroup connecting the two given Node%s from fromNode to toNode.
+    void renameEdge(PlugEdge* edge);
+
+    ///
+    /// \brief Applies style changes in the class' static members to this instance.
+    ///
+    /// Is part of the scene-wide cascade of %updateStyle()-calls after a re-styling of the ZodiacGraph.
     ///
-    static inline uint getHashOf(Node* fromNode, Node* toNode, uint seed=0){
-        return qHash(QPair<Node*, Node*>(fromNode, toNode), seed);
-    }
+    void updateStyle();
 
 private slots:
 
@@ -237,6 +268,11 @@ private: // members
     ///
     QSet<PlugEdge*> m_edges;
 
+    ///
+    /// \brief Produces the label text from the cached names of all PlugEdge%s in this group.
+    ///
+    LabelTextFactory m_labelTextFactory;
+
     ///
     /// \brief StraightEdge to draw when all of the group's PlugEdge%s are hidden.
     ///
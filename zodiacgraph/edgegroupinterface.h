@@ -51,9 +51,18 @@ public: // method
     ///
     /// \brief  Generates a text used for a group of edges.
     ///
+    /// \param [in] page    Page of the label text, is clamped to the available pages.
+    ///
     /// \return Text used for the EdgeLabel.
     ///
-    virtual QString getLabelText() = 0;
+    virtual QString getLabelText(int page) = 0;
+
+    ///
+    /// \brief  The number of pages of the label text of a group of edges.
+    ///
+    /// \return Number of pages, at least 1.
+    ///
+    virtual int getLabelPageCount() = 0;
 
 };
 
@@ -34,6 +34,11 @@ EdgeGroupPair::~EdgeGroupPair()
 
     // As EdgeGroupPairs are always deleted before the rest of the QGraphicsView, this also work on shutdown
 
+    // a released edge is deleted together with all other items of the scene
+    if(!m_edge){
+        return;
+    }
+
     // delete the double edge
     m_edge->getFromNode()->removeStraightEdge(m_edge);
     m_edge->getToNode()->removeStraightEdge(m_edge);
@@ -43,6 +48,13 @@ EdgeGroupPair::~EdgeGroupPair()
     m_edge=nullptr;
 }
 
+void EdgeGroupPair::releaseEdges()
+{
+    m_firstGroup->releaseStraightEdge();
+    m_secondGroup->releaseStraightEdge();
+    m_edge = nullptr;
+}
+
 bool EdgeGroupPair::isEmpty() const
 {
     return((m_firstGroup->getEdgeCount()==0) && (m_secondGroup->getEdgeCount()==0));
@@ -76,22 +88,26 @@ void EdgeGroupPair::updateLabel()
     m_edge->updateLabel();
 }
 
-QString EdgeGroupPair::getLabelText()
+QString EdgeGroupPair::getLabelText(int page)
 {
-    LabelTextFactory firstLabelGroup(m_firstGroup->getEdges());
-    LabelTextFactory secondLabelGroup(m_secondGroup->getEdges());
+    const LabelTextFactory& firstLabelGroup = m_firstGroup->getLabelTextFactory();
+    const LabelTextFactory& secondLabelGroup = m_secondGroup->getLabelTextFactory();
     int maxNameLength = qMax(firstLabelGroup.getMaxNameLength(), secondLabelGroup.getMaxNameLength());
-    int labelCount = firstLabelGroup.getLabelCount() + secondLabelGroup.getLabelCount() + 1;
 
     QStringList labelStrings;
-    labelStrings.reserve(labelCount);
-    labelStrings << firstLabelGroup.produceLabel(maxNameLength);
+    labelStrings.reserve(3);
+    labelStrings << firstLabelGroup.produceLabel(maxNameLength, page);
     labelStrings << LabelTextFactory::getHorizontalLine(maxNameLength);
-    labelStrings << secondLabelGroup.produceLabel(maxNameLength);
+    labelStrings << secondLabelGroup.produceLabel(maxNameLength, page);
     return labelStrings.join(LabelTextFactory::getNewlineChar());
 
 }
 
+int EdgeGroupPair::getLabelPageCount()
+{
+    return qMax(m_firstGroup->getLabelPageCount(), m_secondGroup->getLabelPageCount());
+}
+
 void EdgeGroupPair::updateStyle()
 {
     m_edge->updateStyle();
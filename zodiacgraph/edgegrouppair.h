@@ -67,6 +67,15 @@ public: // methods
     ///
     virtual ~EdgeGroupPair();
 
+    ///
+    /// \brief Lets go of the StraightDoubleEdge and the StraightEdge%s of both groups without removing them from the
+    /// Scene.
+    ///
+    /// Is called by the Scene, when all of its items are deleted at once anyway.
+    /// Afterwards, the pair can only be deleted.
+    ///
+    void releaseEdges();
+
     ///
     /// \brief One of the two EdgeGroup%s in this pair.
     ///
@@ -81,6 +90,13 @@ public: // methods
     ///
     inline EdgeGroup* getSecondGroup() const {return m_secondGroup;}
 
+    ///
+    /// \brief The StraightDoubleEdge drawn in place of both EdgeGroup%s, while all their PlugEdge%s are collapsed.
+    ///
+    /// \return StraightDoubleEdge of this pair.
+    ///
+    inline StraightDoubleEdge* getDoubleEdge() const {return m_edge;}
+
     ///
     /// \brief Tests if none of the two EdgeGroup%s in this pair contain any PlugEdge%s.
     ///
@@ -106,9 +122,20 @@ public: // methods
     ///
     /// \brief Generates the label text for this EdgeGroupPair.
     ///
+    /// Each EdgeGroup shows the given page of its lines, or its last page if it has fewer pages.
+    ///
+    /// \param [in] page    Page of the label text.
+    ///
     /// \return Label text based on the PlugEdge%s contained in both EdgeGroup%s of this pair.
     ///
-    QString getLabelText();
+    QString getLabelText(int page);
+
+    ///
+    /// \brief The number of pages of the label text for this EdgeGroupPair.
+    ///
+    /// \return Number of pages of the EdgeGroup with more pages.
+    ///
+    int getLabelPageCount();
 
     ///
     /// \brief Applies style changes in the class' static members to this instance.
@@ -0,0 +1,107 @@
+#include "edgeindex.h"
+
+#include <QtMath>
+
+#include "baseedge.h"
+#include "utils.h"
+
+namespace zodiac {
+
+qreal EdgeIndex::s_cellSize = 128.;
+
+EdgeIndex::EdgeIndex()
+    : m_cellSize(s_cellSize)
+    , m_cells(QHash<qint64, QSet<BaseEdge*>>())
+    , m_edgeCells(QHash<BaseEdge*, QVector<qint64>>())
+{
+}
+
+void EdgeIndex::updateEdge(BaseEdge* edge, const QList<QPolygonF>& polylines, qreal margin)
+{
+    // a cell is covered, if its circumcircle is within reach of a segment
+    const qreal reach = (m_cellSize*M_SQRT1_2) + margin;
+    QSet<qint64> coveredCells;
+    for(const QPolygonF& polyline : polylines){
+        for(int i = 1; i < polyline.size(); ++i){
+            const QPointF& start = polyline.at(i-1);
+            const QPointF& end = polyline.at(i);
+            QPoint firstCell = getCellOf(QPointF(qMin(start.x(), end.x())-margin, qMin(start.y(), end.y())-margin));
+            QPoint lastCell = getCellOf(QPointF(qMax(start.x(), end.x())+margin, qMax(start.y(), end.y())+margin));
+            for(int y = firstCell.y(); y <= lastCell.y(); ++y){
+                for(int x = firstCell.x(); x <= lastCell.x(); ++x){
+                    QPointF cellCenter((x+.5)*m_cellSize, (y+.5)*m_cellSize);
+                    if(distanceToSegment(cellCenter, start, end)<=reach){
+                        coveredCells.insert(gridCellKey(x, y));
+                    }
+                }
+            }
+        }
+    }
+
+    // replace the old registration
+    removeEdge(edge);
+    QVector<qint64> cellKeys;
+    cellKeys.reserve(coveredCells.size());
+    for(qint64 key : coveredCells){
+        m_cells[key].insert(edge);
+        cellKeys.append(key);
+    }
+    m_edgeCells.insert(edge, cellKeys);
+    edge->m_isInEdgeIndex = true;
+}
+
+void EdgeIndex::removeEdge(BaseEdge* edge)
+{
+    QHash<BaseEdge*, QVector<qint64>>::iterator it = m_edgeCells.find(edge);
+    if(it==m_edgeCells.end()){
+        return;
+    }
+    for(qint64 key : it.value()){
+        QHash<qint64, QSet<BaseEdge*>>::iterator cellIt = m_cells.find(key);
+        if(cellIt==m_cells.end()){
+            continue;
+        }
+        cellIt->remove(edge);
+        if(cellIt->isEmpty()){
+            m_cells.erase(cellIt);
+        }
+    }
+    m_edgeCells.erase(it);
+    edge->m_isInEdgeIndex = false;
+}
+
+void EdgeIndex::clear()
+{
+    for(QHash<BaseEdge*, QVector<qint64>>::const_iterator it = m_edgeCells.constBegin();
+        it != m_edgeCells.constEnd(); ++it){
+        it.key()->m_isInEdgeIndex = false;
+    }
+    m_edgeCells.clear();
+    m_cells.clear();
+}
+
+bool EdgeIndex::isEdgeNear(const BaseEdge* edge, const QPointF& pos) const
+{
+    QPoint cell = getCellOf(pos);
+    QHash<qint64, QSet<BaseEdge*>>::const_iterator cellIt = m_cells.constFind(gridCellKey(cell.x(), cell.y()));
+    if(cellIt==m_cells.constEnd()){
+        return false;
+    }
+    return cellIt->contains(const_cast<BaseEdge*>(edge));
+}
+
+QRectF EdgeIndex::snapToGrid(const QRectF& rect) const
+{
+    qreal left = qFloor(rect.left()/m_cellSize)*m_cellSize;
+    qreal top = qFloor(rect.top()/m_cellSize)*m_cellSize;
+    qreal right = qCeil(rect.right()/m_cellSize)*m_cellSize;
+    qreal bottom = qCeil(rect.bottom()/m_cellSize)*m_cellSize;
+    return QRectF(left, top, right-left, bottom-top);
+}
+
+QPoint EdgeIndex::getCellOf(const QPointF& pos) const
+{
+    return QPoint(qFloor(pos.x()/m_cellSize), qFloor(pos.y()/m_cellSize));
+}
+
+} // namespace zodiac
@@ -0,0 +1,169 @@
+//
+//    ZodiacGraph - A general-purpose, circular node graph UI module.
+//    Copyright (C) 2015  Clemens Sielaff
+//
+//    The MIT License
+//
+//    Permission is hereby granted, free of charge, to any person obtaining a copy of
+//    this software and associated documentation files (the "Software"), to deal in
+//    the Software without restriction, including without limitation the rights to
+//    use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+//    of the Software, and to permit persons to whom the Software is furnished to do so,
+//    subject to the following conditions:
+//
+//    The above copyright notice and this permission notice shall be included in all
+//    copies or substantial portions of the Software.
+//
+//    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//    SOFTWARE.
+//
+
+#ifndef ZODIAC_EDGEINDEX_H
+#define ZODIAC_EDGEINDEX_H
+
+///
+/// \file edgeindex.h
+///
+/// \brief Contains the definition of the zodiac::EdgeIndex class.
+///
+
+#include <QHash>
+#include <QList>
+#include <QPoint>
+#include <QPolygonF>
+#include <QRectF>
+#include <QSet>
+#include <QVector>
+
+namespace zodiac {
+
+class BaseEdge;
+
+///
+/// \brief Spatial index of the edges in a Scene, registering each edge in the grid cells that its segments pass.
+///
+/// The bounding rectangle of a long edge is huge and changes whenever one of its ends is moved.
+/// In the BSP tree of the QGraphicsScene, this means that every change of an edge removes and re-inserts it, and that
+/// a diagonal edge is a candidate for every hit test within its bounding rectangle.
+///
+/// If the Scene uses EdgeIndexMethod::EDGE_GRID, edges report bounds snapped to the cells of this grid to the
+/// QGraphicsScene, so that the BSP tree only needs to change once an edge grows into a new row or column of cells.
+/// The exact footprint of the edge is kept in this index instead, which is used to reject hit tests of edges, whose
+/// snapped bounds contain the tested position, but whose cells do not (see BaseEdge::contains() and
+/// BaseEdge::collidesWithPath()).
+///
+class EdgeIndex
+{
+
+public: // methods
+
+    ///
+    /// \brief Constructor.
+    ///
+    EdgeIndex();
+
+    ///
+    /// \brief Registers an edge with the cells covered by its polylines, replaces any previous registration.
+    ///
+    /// \param [in] edge        Edge to register.
+    /// \param [in] polylines   Polylines approximating the edge in scene coordinates.
+    /// \param [in] margin      Distance around the polylines, which is covered by the edge as well.
+    ///
+    void updateEdge(BaseEdge* edge, const QList<QPolygonF>& polylines, qreal margin);
+
+    ///
+    /// \brief Removes an edge from the index.
+    ///
+    /// \param [in] edge    Edge to remove.
+    ///
+    void removeEdge(BaseEdge* edge);
+
+    ///
+    /// \brief Removes all edges from the index.
+    ///
+    void clear();
+
+    ///
+    /// \brief Tests whether the given edge is registered in the cell containing the given position.
+    ///
+    /// \param [in] edge    Edge to test.
+    /// \param [in] pos     Position in scene coordinates.
+    ///
+    /// \return             <i>true</i> if the edge might pass the position -- <i>false</i> if it certainly does not.
+    ///
+    bool isEdgeNear(const BaseEdge* edge, const QPointF& pos) const;
+
+    ///
+    /// \brief Expands a rectangle outwards to the borders of the grid cells that it covers.
+    ///
+    /// \param [in] rect    Rectangle to expand.
+    ///
+    /// \return             Expanded rectangle.
+    ///
+    QRectF snapToGrid(const QRectF& rect) const;
+
+public: // static methods
+
+    ///
+    /// \brief The side length of a grid cell.
+    ///
+    /// \return Grid cell size in pixels.
+    ///
+    static inline qreal getCellSize() {return s_cellSize;}
+
+    ///
+    /// \brief Sets a new side length of a grid cell.
+    ///
+    /// Only affects EdgeIndex instances created afterwards.
+    ///
+    /// \param [in] size    New grid cell size in pixels, must be larger than zero.
+    ///
+    static inline void setCellSize(qreal size) {s_cellSize=qMax(1., size);}
+
+private: // methods
+
+    ///
+    /// \brief Returns the grid cell containing the given position.
+    ///
+    /// \param [in] pos     Position in scene coordinates.
+    ///
+    /// \return             Grid cell coordinates.
+    ///
+    QPoint getCellOf(const QPointF& pos) const;
+
+private: // members
+
+    ///
+    /// \brief Side length of a grid cell of this index.
+    ///
+    qreal m_cellSize;
+
+    ///
+    /// \brief All occupied grid cells and the edges passing them.
+    ///
+    /// Cells are identified by their packed coordinates, see gridCellKey().
+    ///
+    QHash<qint64, QSet<BaseEdge*>> m_cells;
+
+    ///
+    /// \brief Keys of all cells that each edge in the index is registered in.
+    ///
+    QHash<BaseEdge*, QVector<qint64>> m_edgeCells;
+
+private: // static members
+
+    ///
+    /// \brief Side length of a grid cell used for new EdgeIndex instances.
+    ///
+    static qreal s_cellSize;
+
+};
+
+} // namespace zodiac
+
+#endif // ZODIAC_EDGEINDEX_H
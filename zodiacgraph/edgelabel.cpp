@@ -3,6 +3,7 @@
 #include <QBrush>
 
 #include "utils.h"
+#include "scene.h"
 
 namespace zodiac {
 
@@ -46,4 +47,20 @@ void EdgeLabel::updateStyle()
     }
 }
 
+void EdgeLabel::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget)
+{
+    // labels are skipped while a View renders in draft quality
+    Scene* zodiacScene = static_cast<Scene*>(scene());
+    if(!zodiacScene->areLabelsVisible()){
+        return;
+    }
+    zodiacScene->getCachePolicy().recordRender(CachedItem::EDGE_LABEL);
+    QGraphicsSimpleTextItem::paint(painter, option, widget);
+}
+
+int EdgeLabel::type() const
+{
+    return itemType::EDGE_LABEL_TYPE;
+}
+
 } // namespace zodiac
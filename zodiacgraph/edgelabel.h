@@ -74,6 +74,24 @@ public: // methods
     ///
     void updateStyle();
 
+    ///
+    /// \brief Custom QGraphicsItem type of the EdgeLabel, used by the CachePolicy of the Scene.
+    ///
+    /// \return The type of this item.
+    ///
+    int type() const;
+
+    ///
+    /// \brief Paints this item.
+    ///
+    /// Counts the render with the CachePolicy of the Scene before painting the text.
+    ///
+    /// \param [in] painter Painter used to paint the item.
+    /// \param [in] option  Provides style options for the item.
+    /// \param [in] widget  Optional widget that this item is painted on.
+    ///
+    void paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* widget);
+
 public: // static methods
 
     ///
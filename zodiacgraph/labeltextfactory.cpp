@@ -1,5 +1,9 @@
 #include "labeltextfactory.h"
 
+#include <QStringList>
+
+#include <iterator>                     // for std::advance
+
 #include "node.h"
 #include "plug.h"
 #include "plugedge.h"
@@ -11,21 +15,27 @@ const QString LabelTextFactory::s_dotChar = ".";
 const QString LabelTextFactory::s_whitespaceChar = " ";
 const QString LabelTextFactory::s_newlineChar = "\n";
 const QString LabelTextFactory::s_horizontalLineChar = "—";
+const QString LabelTextFactory::s_summaryTemplate = "+%1 more";
+int LabelTextFactory::s_maxLineCount = 16;
+
+LabelTextFactory::LabelTextFactory()
+    : m_namePairs(QHash<PlugEdge*, NamePair>())
+    , m_order(QMultiMap<QPair<QString, QString>, PlugEdge*>())
+    , m_nameLengths(QMap<int, int>())
+    , m_lineLength(-1)
+    , m_labelPage(0)
+    , m_label(QString())
+    , m_isLabelValid(false)
+{
+}
 
 LabelTextFactory::LabelTextFactory(const QSet<PlugEdge*>& edges)
-    : m_namePairs(QList<QPair<QString, QString>>())
-    , m_labelCount(edges.count())
-    , m_maxNameLength(0)
+    : LabelTextFactory()
 {
     // create and store the label names
-    m_namePairs.reserve(m_labelCount);
-    for(const PlugEdge* edge : edges){
-        Plug* startPlug = edge->getStartPlug();
-        Plug* endPlug = edge->getEndPlug();
-        QString fromName = startPlug->getNode()->getDisplayName() + s_dotChar + startPlug->getName();
-        QString toName = endPlug->getNode()->getDisplayName() + s_dotChar + endPlug->getName();
-        m_maxNameLength = qMax(m_maxNameLength, qMax(fromName.length(), toName.length()));
-        m_namePairs.append(QPair<QString, QString>(fromName, toName));
+    m_namePairs.reserve(edges.count());
+    for(PlugEdge* edge : edges){
+        addEdge(edge);
     }
 }
 
@@ -34,19 +44,106 @@ LabelTextFactory::LabelTextFactory(PlugEdge *edge)
 {
 }
 
-QString LabelTextFactory::produceLabel(int maxNameLength) const
+void LabelTextFactory::addEdge(PlugEdge* edge)
+{
+    if(m_namePairs.contains(edge)){
+        return;
+    }
+    NamePair namePair = createNamePair(edge);
+    countNameLengths(namePair, 1);
+    m_namePairs.insert(edge, namePair);
+    m_order.insert(qMakePair(namePair.fromName, namePair.toName), edge);
+    m_isLabelValid = false;
+}
+
+void LabelTextFactory::removeEdge(PlugEdge* edge)
+{
+    QHash<PlugEdge*, NamePair>::iterator it = m_namePairs.find(edge);
+    if(it==m_namePairs.end()){
+        return;
+    }
+    countNameLengths(it.value(), -1);
+    m_order.remove(qMakePair(it.value().fromName, it.value().toName), edge);
+    m_namePairs.erase(it);
+    m_isLabelValid = false;
+}
+
+void LabelTextFactory::updateEdge(PlugEdge* edge)
+{
+    QHash<PlugEdge*, NamePair>::iterator it = m_namePairs.find(edge);
+    if(it==m_namePairs.end()){
+        return;
+    }
+
+    // only the line of the renamed edge has to be re-created (unless the longest name changes as well)
+    NamePair namePair = createNamePair(edge);
+    if((namePair.fromName==it.value().fromName) && (namePair.toName==it.value().toName)){
+        return;
+    }
+    countNameLengths(it.value(), -1);
+    countNameLengths(namePair, 1);
+    m_order.remove(qMakePair(it.value().fromName, it.value().toName), edge);
+    m_order.insert(qMakePair(namePair.fromName, namePair.toName), edge);
+    it.value() = namePair;
+    m_isLabelValid = false;
+}
+
+QString LabelTextFactory::produceLabel(int maxNameLength, int page) const
 {
     // center the arrow by pre- or appending whitespace to the shorter name
-    maxNameLength = qMax(maxNameLength, m_maxNameLength);
+    maxNameLength = qMax(maxNameLength, getMaxNameLength());
+    page = qBound(0, page, getPageCount()-1);
+    if((m_isLabelValid) && (maxNameLength==m_lineLength) && (page==m_labelPage)){
+        return m_label;
+    }
+
+    // if the name length has changed, all lines have to be padded anew
+    if(maxNameLength!=m_lineLength){
+        for(NamePair& namePair : m_namePairs){
+            namePair.line = QString();
+        }
+        m_lineLength = maxNameLength;
+    }
+
+    // only the lines on the requested page are produced
+    int lineCount = m_order.size();
+    int firstLine = 0;
+    if((s_maxLineCount>0) && (lineCount>s_maxLineCount)){
+        firstLine = page*s_maxLineCount;
+        lineCount = qMin(s_maxLineCount, m_order.size()-firstLine);
+    }
     QStringList labelStrings;
-    labelStrings.reserve(m_labelCount);
-    for(const QPair<QString, QString>& labelPair : m_namePairs){
-        labelStrings.append(
-                    s_whitespaceChar.repeated(maxNameLength-labelPair.first.length())
-                    + labelPair.first + s_arrowChar + labelPair.second +
-                    s_whitespaceChar.repeated(maxNameLength-labelPair.second.length()));
+    labelStrings.reserve(lineCount+1);
+    QMultiMap<QPair<QString, QString>, PlugEdge*>::const_iterator it = m_order.constBegin();
+    std::advance(it, firstLine);
+    for(int i = 0; i < lineCount; ++i, ++it){
+        NamePair& namePair = m_namePairs[it.value()];
+        if(namePair.line.isNull()){
+            namePair.line = s_whitespaceChar.repeated(maxNameLength-namePair.fromName.length())
+                    + namePair.fromName + s_arrowChar + namePair.toName +
+                    s_whitespaceChar.repeated(maxNameLength-namePair.toName.length());
+        }
+        labelStrings.append(namePair.line);
+    }
+
+    // summarize the lines that were left out
+    int hiddenCount = m_order.size()-lineCount;
+    if(hiddenCount>0){
+        labelStrings.append(getSummaryLine(hiddenCount, maxNameLength));
     }
-    return labelStrings.join(s_newlineChar);
+
+    m_label = labelStrings.join(s_newlineChar);
+    m_labelPage = page;
+    m_isLabelValid = true;
+    return m_label;
+}
+
+int LabelTextFactory::getPageCount() const
+{
+    if((s_maxLineCount==0) || (m_order.size()<=s_maxLineCount)){
+        return 1;
+    }
+    return (m_order.size()+s_maxLineCount-1)/s_maxLineCount;
 }
 
 QString LabelTextFactory::getHorizontalLine(int maxNameLength)
@@ -75,5 +172,33 @@ QString LabelTextFactory::getHorizontalLine(int maxNameLength)
             s_whitespaceChar.repeated(spacesBefore+(whitespace%2));
 }
 
-} // namespace zodiac
+LabelTextFactory::NamePair LabelTextFactory::createNamePair(const PlugEdge* edge)
+{
+    Plug* startPlug = edge->getStartPlug();
+    Plug* endPlug = edge->getEndPlug();
+    NamePair namePair;
+    namePair.fromName = startPlug->getNode()->getDisplayName() + s_dotChar + startPlug->getName();
+    namePair.toName = endPlug->getNode()->getDisplayName() + s_dotChar + endPlug->getName();
+    return namePair;
+}
+
+QString LabelTextFactory::getSummaryLine(int count, int maxNameLength)
+{
+    QString summary = s_summaryTemplate.arg(count);
+    int whitespace = qMax(0, (maxNameLength*2)+s_arrowChar.length()-summary.length());
+    int spacesBefore = whitespace/2;
+    return s_whitespaceChar.repeated(spacesBefore) + summary + s_whitespaceChar.repeated(whitespace-spacesBefore);
+}
 
+void LabelTextFactory::countNameLengths(const NamePair& namePair, int delta)
+{
+    for(int length : {namePair.fromName.length(), namePair.toName.length()}){
+        int& count = m_nameLengths[length];
+        count += delta;
+        if(count<=0){
+            m_nameLengths.remove(length);
+        }
+    }
+}
+
+} // namespace zodiac
@@ -32,6 +32,9 @@
 /// \brief Contains the definition of the zodiac::LabelTextFactory class.
 ///
 
+#include <QHash>
+#include <QMap>
+#include <QPair>
 #include <QSet>
 #include <QString>
 
@@ -44,11 +47,27 @@ class PlugEdge;
 ///
 /// The challenge is to produce text that appears centered around the arrow denoting the direction of the edge flow.
 ///
+/// A factory can also be kept around and updated incrementally, as it is done by the EdgeGroup.
+/// It caches the names of each PlugEdge and the padded line of its label, so that adding, removing or renaming a
+/// single PlugEdge only re-creates its own line -- unless the length of the longest name changes, in which case all
+/// lines have to be padded anew.
+///
+/// The lines are sorted by name.
+/// Groups of thousands of PlugEdge%s would produce labels thousands of lines tall, which are expensive to lay out and
+/// to cache, therefore a label never shows more than getMaxLineCount() lines, followed by a summary of the lines left
+/// out.
+/// The remaining lines can be shown on later pages of the label.
+///
 class LabelTextFactory
 {
 
 public: // methods
 
+    ///
+    /// \brief Default constructor, creates an empty factory.
+    ///
+    LabelTextFactory();
+
     ///
     /// \brief Constructor.
     ///
@@ -63,6 +82,27 @@ public: // methods
     ///
     explicit LabelTextFactory(PlugEdge* edge);
 
+    ///
+    /// \brief Adds the names of a PlugEdge to the label.
+    ///
+    /// \param [in] edge    PlugEdge to add.
+    ///
+    void addEdge(PlugEdge* edge);
+
+    ///
+    /// \brief Removes the names of a PlugEdge from the label.
+    ///
+    /// \param [in] edge    PlugEdge to remove.
+    ///
+    void removeEdge(PlugEdge* edge);
+
+    ///
+    /// \brief Updates the names of a PlugEdge after one of its Plug%s or Node%s was renamed.
+    ///
+    /// \param [in] edge    PlugEdge to update.
+    ///
+    void updateEdge(PlugEdge* edge);
+
     ///
     /// \brief Produces the label string.
     ///
@@ -70,25 +110,35 @@ public: // methods
     /// This is useful for EdgeGroupPair%s that have two LabelTextFactory%s that have to produce a single label that is
     /// centered around the arrow from both.
     ///
+    /// The label is cached until the factory changes or it is produced with another name length or page.
+    ///
     /// \param [in] maxNameLength   (optional) Overrides the default length of the longest name
+    /// \param [in] page            (optional) Page of the label to produce, is clamped to the available pages.
     ///
     /// \return                     Label string.
     ///
-    QString produceLabel(int maxNameLength = 0) const;
+    QString produceLabel(int maxNameLength = 0, int page = 0) const;
+
+    ///
+    /// \brief The number of pages of the label.
+    ///
+    /// \return Number of pages, at least 1.
+    ///
+    int getPageCount() const;
 
     ///
     /// \brief The number of individual labels in this factory.
     ///
     /// \return Number of labels.
     ///
-    int getLabelCount() const {return m_labelCount;}
+    int getLabelCount() const {return m_namePairs.size();}
 
     ///
     /// \brief The number of characters in the longest name of all labels.
     ///
     /// \return Maximum name length.
     ///
-    int getMaxNameLength() const {return m_maxNameLength;}
+    int getMaxNameLength() const {return m_nameLengths.isEmpty() ? 0 : m_nameLengths.lastKey();}
 
 public: // static methods
 
@@ -112,24 +162,100 @@ public: // static methods
     ///
     static QString getHorizontalLine(int maxNameLength);
 
-private: // members
+    ///
+    /// \brief The largest number of lines on a page of the label.
+    ///
+    /// \return Maximal line count per page, 0 if the labels are unbounded.
+    ///
+    static int getMaxLineCount() {return s_maxLineCount;}
+
+    ///
+    /// \brief Sets the largest number of lines on a page of the label.
+    ///
+    /// Only affects labels that are produced anew afterwards.
+    ///
+    /// \param [in] count   New maximal line count per page, 0 for unbounded labels.
+    ///
+    static void setMaxLineCount(int count) {s_maxLineCount=qMax(0, count);}
+
+private: // types
 
     ///
-    /// \brief List of a pair of label names.
+    /// \brief The two names of a single label and its padded line.
     ///
     /// A <i>name</i> is one half of the label -- two <i>names</i> are connected using an arrow.
     ///
-    QList<QPair<QString, QString>> m_namePairs;
+    struct NamePair {
+        QString fromName;   ///< Name of the start Plug, including its Node.
+        QString toName;     ///< Name of the end Plug, including its Node.
+        QString line;       ///< Padded line of the label, null if it has to be re-created.
+    };
 
+private: // methods
+
+    ///
+    /// \brief Creates the names of a PlugEdge.
     ///
-    /// \brief The number of labels taken into account.
+    /// \param [in] edge    PlugEdge to name.
     ///
-    int m_labelCount;
+    /// \return             Names of the PlugEdge without a line.
+    ///
+    static NamePair createNamePair(const PlugEdge* edge);
 
     ///
-    /// \brief Character count of the longest name in all labels.
+    /// \brief Counts or un-counts the lengths of the names of a label.
+    ///
+    /// \param [in] namePair    Names of the label.
+    /// \param [in] delta       <i>1</i> to count the names -- <i>-1</i> to un-count them.
     ///
-    int m_maxNameLength;
+    void countNameLengths(const NamePair& namePair, int delta);
+
+    ///
+    /// \brief Produces a line summarizing the lines left out of the label.
+    ///
+    /// \param [in] count           Number of lines left out.
+    /// \param [in] maxNameLength   The length of the longest name.
+    ///
+    /// \return                     Summary line, centered around the arrow.
+    ///
+    static QString getSummaryLine(int count, int maxNameLength);
+
+private: // members
+
+    ///
+    /// \brief The pair of label names for each PlugEdge.
+    ///
+    mutable QHash<PlugEdge*, NamePair> m_namePairs;
+
+    ///
+    /// \brief All PlugEdge%s sorted by their names, in the order in which they appear in the label.
+    ///
+    QMultiMap<QPair<QString, QString>, PlugEdge*> m_order;
+
+    ///
+    /// \brief Number of names for each name length, the last key is the length of the longest name.
+    ///
+    QMap<int, int> m_nameLengths;
+
+    ///
+    /// \brief Name length to which the cached lines are padded, -1 if there are none.
+    ///
+    mutable int m_lineLength;
+
+    ///
+    /// \brief Page of the cached label.
+    ///
+    mutable int m_labelPage;
+
+    ///
+    /// \brief Cached label produced from the lines of a page.
+    ///
+    mutable QString m_label;
+
+    ///
+    /// \brief Whether the cached label is up-to-date.
+    ///
+    mutable bool m_isLabelValid;
 
 private: // static members
 
@@ -164,6 +290,16 @@ private: // static members
     ///
     static const QString s_horizontalLineChar;
 
+    ///
+    /// \brief Template of the line summarizing the lines left out of a label.
+    ///
+    static const QString s_summaryTemplate;
+
+    ///
+    /// \brief Largest number of lines on a page of a label, 0 for unbounded labels.
+    ///
+    static int s_maxLineCount;
+
 };
 
 } // namespace zodiac
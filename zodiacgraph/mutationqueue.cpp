@@ -0,0 +1,306 @@
+#include "mutationqueue.h"
+
+#include <QElapsedTimer>
+#include <QMetaObject>
+
+#include "node.h"
+#include "plug.h"
+#include "plugedge.h"
+#include "scene.h"
+
+namespace zodiac {
+
+const int MutationQueue::s_defaultCapacity = 4096;
+const int MutationQueue::s_defaultTimeBudget = 8;
+
+Mutation Mutation::createNode(const QUuid& node, const QString& name, const QPointF& pos)
+{
+    Mutation mutation;
+    mutation.type = Type::CREATE_NODE;
+    mutation.node = node;
+    mutation.name = name;
+    mutation.pos = pos;
+    return mutation;
+}
+
+Mutation Mutation::removeNode(const QUuid& node)
+{
+    Mutation mutation;
+    mutation.type = Type::REMOVE_NODE;
+    mutation.node = node;
+    return mutation;
+}
+
+Mutation Mutation::renameNode(const QUuid& node, const QString& name)
+{
+    Mutation mutation;
+    mutation.type = Type::RENAME_NODE;
+    mutation.node = node;
+    mutation.name = name;
+    return mutation;
+}
+
+Mutation Mutation::moveNode(const QUuid& node, const QPointF& pos)
+{
+    Mutation mutation;
+    mutation.type = Type::MOVE_NODE;
+    mutation.node = node;
+    mutation.pos = pos;
+    return mutation;
+}
+
+Mutation Mutation::createPlug(const QUuid& node, const QString& plug, bool incoming)
+{
+    Mutation mutation;
+    mutation.type = incoming ? Type::CREATE_INCOMING_PLUG : Type::CREATE_OUTGOING_PLUG;
+    mutation.node = node;
+    mutation.plug = plug;
+    return mutation;
+}
+
+Mutation Mutation::removePlug(const QUuid& node, const QString& plug)
+{
+    Mutation mutation;
+    mutation.type = Type::REMOVE_PLUG;
+    mutation.node = node;
+    mutation.plug = plug;
+    return mutation;
+}
+
+Mutation Mutation::renamePlug(const QUuid& node, const QString& plug, const QString& name)
+{
+    Mutation mutation;
+    mutation.type = Type::RENAME_PLUG;
+    mutation.node = node;
+    mutation.plug = plug;
+    mutation.name = name;
+    return mutation;
+}
+
+Mutation Mutation::connectPlugs(const QUuid& outNode, const QString& outPlug,
+                                const QUuid& inNode, const QString& inPlug)
+{
+    Mutation mutation;
+    mutation.type = Type::CONNECT_PLUGS;
+    mutation.node = outNode;
+    mutation.plug = outPlug;
+    mutation.otherNode = inNode;
+    mutation.otherPlug = inPlug;
+    return mutation;
+}
+
+Mutation Mutation::disconnectPlugs(const QUuid& outNode, const QString& outPlug,
+                                   const QUuid& inNode, const QString& inPlug)
+{
+    Mutation mutation = connectPlugs(outNode, outPlug, inNode, inPlug);
+    mutation.type = Type::DISCONNECT_PLUGS;
+    return mutation;
+}
+
+MutationQueue::MutationQueue(Scene* scene, int capacity)
+    : QObject(scene)
+    , m_scene(scene)
+    , m_cells(nullptr)
+    , m_mask(0)
+    , m_pushPosition(0)
+    , m_popPosition(0)
+    , m_isDrainScheduled(0)
+    , m_timeBudget(s_defaultTimeBudget)
+    , m_pendingRemovals(QList<Node*>())
+{
+    // the capacity is a power of two, so positions can be mapped to slots with a mask
+    quintptr size = 2;
+    while(size < quintptr(qMax(2, capacity))){
+        size *= 2;
+    }
+    m_mask = size-1;
+
+    // each slot starts out free for the first position that maps onto it
+    m_cells = new Cell[size];
+    for(quintptr position = 0; position < size; ++position){
+        m_cells[position].sequence.store(position);
+    }
+}
+
+MutationQueue::~MutationQueue()
+{
+    delete[] m_cells;
+}
+
+bool MutationQueue::push(const Mutation& mutation)
+{
+    // claim a position whose slot has been freed by the consumer
+    Cell* cell;
+    quintptr position = m_pushPosition.load();
+    while(true){
+        cell = &m_cells[position & m_mask];
+        qintptr difference = qintptr(cell->sequence.loadAcquire()) - qintptr(position);
+        if(difference == 0){
+            if(m_pushPosition.testAndSetRelaxed(position, position+1)){
+                break;
+            }
+            position = m_pushPosition.load();
+        } else if(difference < 0){
+            return false; // the slot still holds a Mutation from one lap ago, the queue is full
+        } else {
+            position = m_pushPosition.load(); // another producer claimed the position first
+        }
+    }
+
+    // fill the slot and hand it over to the consumer
+    cell->mutation = mutation;
+    cell->sequence.storeRelease(position+1);
+
+    scheduleDrain();
+    return true;
+}
+
+void MutationQueue::drain()
+{
+    // Mutations pushed from now on schedule the next batch themselves
+    m_isDrainScheduled.fetchAndStoreOrdered(0);
+
+    QElapsedTimer timer;
+    timer.start();
+    int appliedCount = 0;
+    int skippedCount = 0;
+    Mutation mutation;
+    while(pop(mutation)){
+        if(apply(mutation)){
+            ++appliedCount;
+        } else {
+            ++skippedCount;
+        }
+
+        // continue in the next pass of the event loop once the budget is spent
+        if(timer.elapsed() >= m_timeBudget){
+            scheduleDrain();
+            break;
+        }
+    }
+    removePendingNodes();
+
+    if(appliedCount+skippedCount > 0){
+        emit batchApplied(appliedCount, skippedCount);
+    }
+}
+
+bool MutationQueue::pop(Mutation& mutation)
+{
+    Cell& cell = m_cells[m_popPosition & m_mask];
+    if(qintptr(cell.sequence.loadAcquire()) - qintptr(m_popPosition+1) < 0){
+        return false; // the next producer has not finished filling the slot yet
+    }
+
+    // take the Mutation and free the slot for the producers of the next lap
+    mutation = cell.mutation;
+    cell.mutation = Mutation();
+    cell.sequence.storeRelease(m_popPosition+m_mask+1);
+    ++m_popPosition;
+    return true;
+}
+
+void MutationQueue::scheduleDrain()
+{
+    if(m_isDrainScheduled.testAndSetOrdered(0, 1)){
+        QMetaObject::invokeMethod(this, "drain", Qt::QueuedConnection);
+    }
+}
+
+bool MutationQueue::apply(const Mutation& mutation)
+{
+    // consecutive removals are applied together, everything else has to wait until they are done
+    if(mutation.type == Mutation::Type::REMOVE_NODE){
+        Node* node = m_scene->getNode(mutation.node);
+        if(!node){
+            return false;
+        }
+        m_pendingRemovals.append(node);
+        return true;
+    }
+    removePendingNodes();
+
+    // creating a Node is the only Mutation that does not require an existing one
+    Node* node = m_scene->getNode(mutation.node);
+    if(mutation.type == Mutation::Type::CREATE_NODE){
+        if(node){
+            return false;
+        }
+        m_scene->createNode(mutation.name, mutation.node)->setPos(mutation.pos);
+        return true;
+    }
+    if(!node){
+        return false;
+    }
+
+    switch(mutation.type){
+    case Mutation::Type::RENAME_NODE:
+        node->setDisplayName(mutation.name);
+        return true;
+
+    case Mutation::Type::MOVE_NODE:
+        node->setPos(mutation.pos);
+        return true;
+
+    case Mutation::Type::CREATE_INCOMING_PLUG:
+        node->createPlug(mutation.plug, PlugDirection::IN);
+        return true;
+
+    case Mutation::Type::CREATE_OUTGOING_PLUG:
+        node->createPlug(mutation.plug, PlugDirection::OUT);
+        return true;
+
+    case Mutation::Type::REMOVE_PLUG:
+    {
+        Plug* plug = node->getPlug(mutation.plug);
+        return plug && node->removePlug(plug);
+    }
+
+    case Mutation::Type::RENAME_PLUG:
+    {
+        Plug* plug = node->getPlug(mutation.plug);
+        if(!plug){
+            return false;
+        }
+        node->renamePlug(plug, mutation.name);
+        return true;
+    }
+
+    case Mutation::Type::CONNECT_PLUGS:
+    case Mutation::Type::DISCONNECT_PLUGS:
+    {
+        Node* otherNode = m_scene->getNode(mutation.otherNode);
+        if(!otherNode){
+            return false;
+        }
+        Plug* fromPlug = node->getPlug(mutation.plug);
+        Plug* toPlug = otherNode->getPlug(mutation.otherPlug);
+        if(!fromPlug || !toPlug){
+            return false;
+        }
+        if(mutation.type == Mutation::Type::CONNECT_PLUGS){
+            return m_scene->createEdge(fromPlug, toPlug) != nullptr;
+        }
+        PlugEdge* edge = m_scene->getEdge(fromPlug, toPlug);
+        if(!edge){
+            return false;
+        }
+        m_scene->removeEdge(edge);
+        return true;
+    }
+
+    default:
+        return false;
+    }
+}
+
+void MutationQueue::removePendingNodes()
+{
+    if(m_pendingRemovals.isEmpty()){
+        return;
+    }
+    m_scene->removeNodes(m_pendingRemovals);
+    m_pendingRemovals.clear();
+}
+
+} // namespace zodiac
@@ -0,0 +1,366 @@
+//
+//    ZodiacGraph - A general-purpose, circular node graph UI module.
+//    Copyright (C) 2015  Clemens Sielaff
+//
+//    The MIT License
+//
+//    Permission is hereby granted, free of charge, to any person obtaining a copy of
+//    this software and associated documentation files (the "Software"), to deal in
+//    the Software without restriction, including without limitation the rights to
+//    use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+//    of the Software, and to permit persons to whom the Software is furnished to do so,
+//    subject to the following conditions:
+//
+//    The above copyright notice and this permission notice shall be included in all
+//    copies or substantial portions of the Software.
+//
+//    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//    SOFTWARE.
+//
+
+#ifndef ZODIAC_MUTATIONQUEUE_H
+#define ZODIAC_MUTATIONQUEUE_H
+
+///
+/// \file mutationqueue.h
+///
+/// \brief Contains the definition of the zodiac::MutationQueue class.
+///
+
+#include <QAtomicInteger>
+#include <QList>
+#include <QObject>
+#include <QPointF>
+#include <QString>
+#include <QUuid>
+
+namespace zodiac {
+
+class Node;
+class Scene;
+
+///
+/// \brief A single change to the graph, recorded by any thread and applied to the Scene by the MutationQueue.
+///
+/// Node%s are identified by their unique identifier and Plug%s by the name on their Node, because pointers and handles
+/// must not be used outside the GUI thread.
+/// Use the static functions to create the records, they only fill in the fields that are used by the mutation.
+///
+struct Mutation {
+
+    ///
+    /// \brief The kind of change.
+    ///
+    enum class Type : quint8 {
+        CREATE_NODE,            ///< Creates Node <i>node</i> with name <i>name</i> at position <i>pos</i>.
+        REMOVE_NODE,            ///< Removes Node <i>node</i> together with all of its connections.
+        RENAME_NODE,            ///< Renames Node <i>node</i> to <i>name</i>.
+        MOVE_NODE,              ///< Moves Node <i>node</i> to position <i>pos</i>.
+        CREATE_INCOMING_PLUG,   ///< Creates the incoming Plug <i>plug</i> on Node <i>node</i>.
+        CREATE_OUTGOING_PLUG,   ///< Creates the outgoing Plug <i>plug</i> on Node <i>node</i>.
+        REMOVE_PLUG,            ///< Removes the unconnected Plug <i>plug</i> of Node <i>node</i>.
+        RENAME_PLUG,            ///< Renames Plug <i>plug</i> of Node <i>node</i> to <i>name</i>.
+        CONNECT_PLUGS,          ///< Connects outgoing <i>node.plug</i> with incoming <i>otherNode.otherPlug</i>.
+        DISCONNECT_PLUGS,       ///< Disconnects outgoing <i>node.plug</i> from incoming <i>otherNode.otherPlug</i>.
+    };
+
+    Type type;          ///< Kind of change.
+    QUuid node;         ///< Node to change, or the Node of the outgoing Plug of a connection.
+    QString plug;       ///< Plug to change, or the outgoing Plug of a connection.
+    QUuid otherNode;    ///< Node of the incoming Plug of a connection.
+    QString otherPlug;  ///< Incoming Plug of a connection.
+    QString name;       ///< New name of a Node or Plug.
+    QPointF pos;        ///< New position of a Node.
+
+    ///
+    /// \brief Creates a Node, unless a Node with the same identifier exists already.
+    ///
+    /// \param [in] node    Unique identifier of the new Node.
+    /// \param [in] name    Name of the new Node.
+    /// \param [in] pos     (optional) Position of the new Node in the Scene.
+    ///
+    /// \return             The Mutation record.
+    ///
+    static Mutation createNode(const QUuid& node, const QString& name, const QPointF& pos = QPointF());
+
+    ///
+    /// \brief Removes a Node together with all of its connections.
+    ///
+    /// \param [in] node    Unique identifier of the Node to remove.
+    ///
+    /// \return             The Mutation record.
+    ///
+    static Mutation removeNode(const QUuid& node);
+
+    ///
+    /// \brief Renames a Node.
+    ///
+    /// \param [in] node    Unique identifier of the Node to rename.
+    /// \param [in] name    New name of the Node.
+    ///
+    /// \return             The Mutation record.
+    ///
+    static Mutation renameNode(const QUuid& node, const QString& name);
+
+    ///
+    /// \brief Moves a Node.
+    ///
+    /// \param [in] node    Unique identifier of the Node to move.
+    /// \param [in] pos     New position of the Node in the Scene.
+    ///
+    /// \return             The Mutation record.
+    ///
+    static Mutation moveNode(const QUuid& node, const QPointF& pos);
+
+    ///
+    /// \brief Creates a new Plug on a Node.
+    ///
+    /// \param [in] node        Unique identifier of the Node.
+    /// \param [in] plug        Name of the new Plug.
+    /// \param [in] incoming    <i>true</i> for an incoming Plug -- <i>false</i> for an outgoing one.
+    ///
+    /// \return                 The Mutation record.
+    ///
+    static Mutation createPlug(const QUuid& node, const QString& plug, bool incoming);
+
+    ///
+    /// \brief Removes a Plug without connections from its Node.
+    ///
+    /// \param [in] node    Unique identifier of the Node.
+    /// \param [in] plug    Name of the Plug to remove.
+    ///
+    /// \return             The Mutation record.
+    ///
+    static Mutation removePlug(const QUuid& node, const QString& plug);
+
+    ///
+    /// \brief Renames a Plug.
+    ///
+    /// \param [in] node    Unique identifier of the Node.
+    /// \param [in] plug    Current name of the Plug.
+    /// \param [in] name    New name of the Plug.
+    ///
+    /// \return             The Mutation record.
+    ///
+    static Mutation renamePlug(const QUuid& node, const QString& plug, const QString& name);
+
+    ///
+    /// \brief Connects an outgoing with an incoming Plug.
+    ///
+    /// \param [in] outNode Unique identifier of the Node of the outgoing Plug.
+    /// \param [in] outPlug Name of the outgoing Plug.
+    /// \param [in] inNode  Unique identifier of the Node of the incoming Plug.
+    /// \param [in] inPlug  Name of the incoming Plug.
+    ///
+    /// \return             The Mutation record.
+    ///
+    static Mutation connectPlugs(const QUuid& outNode, const QString& outPlug,
+                                 const QUuid& inNode, const QString& inPlug);
+
+    ///
+    /// \brief Removes the connection between an outgoing and an incoming Plug.
+    ///
+    /// \param [in] outNode Unique identifier of the Node of the outgoing Plug.
+    /// \param [in] outPlug Name of the outgoing Plug.
+    /// \param [in] inNode  Unique identifier of the Node of the incoming Plug.
+    /// \param [in] inPlug  Name of the incoming Plug.
+    ///
+    /// \return             The Mutation record.
+    ///
+    static Mutation disconnectPlugs(const QUuid& outNode, const QString& outPlug,
+                                    const QUuid& inNode, const QString& inPlug);
+};
+
+///
+/// \brief Feeds Mutation%s from any number of threads into a Scene.
+///
+/// The Scene may only be changed from the GUI thread.
+/// Instead of sending every single change through a queued connection, producer threads push() compact Mutation
+/// records into a bounded ring buffer without taking a lock.
+/// The GUI thread drains the queue in batches, each of which stops after a time budget, so that a flood of changes
+/// never blocks the event loop for long.
+/// Whatever is left is applied in the next pass of the event loop.
+///
+/// Mutation%s of a single producer are applied in the order in which they were pushed.
+/// Mutation%s referring to Node%s or Plug%s that do not exist (anymore) are skipped.
+/// Since Plug%s are identified by name, producers should use names that are unique on their Node -- otherwise the
+/// Node appends a suffix to the name, which the producer does not know about.
+///
+/// The queue must be created in the GUI thread.
+///
+class MutationQueue : public QObject
+{
+
+    Q_OBJECT
+
+public: // methods
+
+    ///
+    /// \brief Constructor.
+    ///
+    /// \param [in] scene       Scene to apply the Mutation%s to, is the Qt parent of the queue.
+    /// \param [in] capacity    Minimal number of Mutation%s the queue can hold, is rounded up to a power of two.
+    ///
+    explicit MutationQueue(Scene* scene, int capacity = s_defaultCapacity);
+
+    ///
+    /// \brief Destructor.
+    ///
+    ~MutationQueue();
+
+    ///
+    /// \brief Adds a Mutation to the queue, can be called from any thread.
+    ///
+    /// Does not block and does not allocate memory apart from copying the Mutation's strings.
+    ///
+    /// \param [in] mutation    Mutation to apply to the Scene.
+    ///
+    /// \return                 <i>true</i> if the Mutation was queued -- <i>false</i> if the queue is full.
+    ///
+    bool push(const Mutation& mutation);
+
+    ///
+    /// \brief Number of Mutation%s the queue can hold at once.
+    ///
+    /// \return Capacity of the queue.
+    ///
+    inline int getCapacity() const {return int(m_mask+1);}
+
+    ///
+    /// \brief Maximum time in milliseconds spent applying Mutation%s in one pass of the event loop.
+    ///
+    /// \return Time budget of each batch in milliseconds.
+    ///
+    inline int getTimeBudget() const {return m_timeBudget;}
+
+    ///
+    /// \brief Sets the maximum time spent applying Mutation%s in one pass of the event loop.
+    ///
+    /// \param [in] milliseconds    Time budget of each batch in milliseconds, at least one Mutation is always applied.
+    ///
+    inline void setTimeBudget(int milliseconds) {m_timeBudget=qMax(0, milliseconds);}
+
+signals:
+
+    ///
+    /// \brief Is emitted after each batch of Mutation%s was applied to the Scene.
+    ///
+    /// \param [out] applied    Number of applied Mutation%s.
+    /// \param [out] skipped    Number of Mutation%s that referred to missing Node%s or Plug%s or had no effect.
+    ///
+    void batchApplied(int applied, int skipped);
+
+private slots:
+
+    ///
+    /// \brief Applies queued Mutation%s to the Scene until the queue is empty or the time budget is spent.
+    ///
+    void drain();
+
+private: // struct
+
+    ///
+    /// \brief A single slot of the ring buffer.
+    ///
+    /// The sequence number tells producers and the consumer whose turn it is to use the slot.
+    ///
+    struct Cell {
+        QAtomicInteger<quintptr> sequence;  ///< Position in the queue for which the slot is free or filled.
+        Mutation mutation;                  ///< The stored Mutation.
+    };
+
+private: // methods
+
+    ///
+    /// \brief Takes the next Mutation from the queue, must only be called from the GUI thread.
+    ///
+    /// \param [out] mutation   Is filled with the next Mutation.
+    ///
+    /// \return                 <i>true</i> if a Mutation was taken -- <i>false</i> if the queue is empty.
+    ///
+    bool pop(Mutation& mutation);
+
+    ///
+    /// \brief Makes sure that drain() is called in the next pass of the event loop.
+    ///
+    void scheduleDrain();
+
+    ///
+    /// \brief Applies a single Mutation to the Scene.
+    ///
+    /// Removals of Node%s are collected and applied together by removePendingNodes().
+    ///
+    /// \param [in] mutation    Mutation to apply.
+    ///
+    /// \return                 <i>true</i> if the Mutation was applied -- <i>false</i> if it was skipped.
+    ///
+    bool apply(const Mutation& mutation);
+
+    ///
+    /// \brief Removes all collected Node%s from the Scene at once.
+    ///
+    void removePendingNodes();
+
+private: // members
+
+    ///
+    /// \brief The Scene to apply the Mutation%s to.
+    ///
+    Scene* m_scene;
+
+    ///
+    /// \brief The ring buffer.
+    ///
+    Cell* m_cells;
+
+    ///
+    /// \brief Capacity minus one, to map positions to slots.
+    ///
+    quintptr m_mask;
+
+    ///
+    /// \brief Next position to be claimed by a producer.
+    ///
+    QAtomicInteger<quintptr> m_pushPosition;
+
+    ///
+    /// \brief Next position to be taken by the consumer, only used by the GUI thread.
+    ///
+    quintptr m_popPosition;
+
+    ///
+    /// \brief Is 1 while a call to drain() is scheduled -- 0 otherwise.
+    ///
+    QAtomicInt m_isDrainScheduled;
+
+    ///
+    /// \brief Maximum time in milliseconds spent applying Mutation%s in one pass of the event loop.
+    ///
+    int m_timeBudget;
+
+    ///
+    /// \brief Node%s to be removed by removePendingNodes().
+    ///
+    QList<Node*> m_pendingRemovals;
+
+private: // static members
+
+    ///
+    /// \brief Default capacity of a MutationQueue.
+    ///
+    static const int s_defaultCapacity;
+
+    ///
+    /// \brief Default time budget of each batch in milliseconds, about half a frame at 60Hz.
+    ///
+    static const int s_defaultTimeBudget;
+};
+
+} // namespace zodiac
+
+#endif // ZODIAC_MUTATIONQUEUE_H
@@ -11,20 +11,24 @@
 #include <QtMath>                       // for M_PI
 #include <QVector2D>
 
+#include <algorithm>                    // for std::lower_bound, std::sort
 #include <cfloat>                       // for DBL_MAX
 
+#include "draglayer.h"
 #include "edgegroupinterface.h"
 #include "nodelabel.h"
 #include "utils.h"
 #include "plug.h"
 #include "scene.h"
+#include "signalhub.h"
 #include "view.h"
 #include "perimeter.h"
 #include "plugarranger.h"
 #include "straightedge.h"
 
 static void fireAnimation(QPropertyAnimation& animation, qreal targetValue, qreal startValue, qreal duration, const QEasingCurve& curve);
-static zodiac::Plug* findClosestPlug(const QPointF& pos, const QSet<zodiac::Plug*> &plugs, zodiac::Plug* closest);
+static zodiac::Plug* findClosestPlug(qreal angle, const QVector<QPair<qreal, zodiac::Plug*>>& plugIndex,
+                                     zodiac::Plug* closest, qreal& closestDistance);
 static qreal angularDistance(qreal alpha, qreal beta);
 
 namespace zodiac {
@@ -55,7 +59,10 @@ Node::Node(Scene* scene, const QString &displayName, const QUuid &uuid)
     , m_allPlugs(QMap<QString, Plug*>())
     , m_outgoingPlugs(QSet<Plug*>())
     , m_incomingPlugs(QSet<Plug*>())
+    , m_outgoingPlugIndex(QVector<QPair<qreal, Plug*>>())
+    , m_incomingPlugIndex(QVector<QPair<qreal, Plug*>>())
     , m_straightEdges(QSet<StraightEdge*>())
+    , m_edgeGroupPairs(QHash<Node*, EdgeGroupPair*>())
     , m_label(nullptr)
     , m_expansionState(NodeExpansion::NONE)
     , m_lastExpansionState(NodeExpansion::NONE)
@@ -64,12 +71,17 @@ Node::Node(Scene* scene, const QString &displayName, const QUuid &uuid)
     setFlag(ItemIsMovable);
     setFlag(ItemIsSelectable);
     setFlag(ItemIsFocusable);
+    setFlag(ItemSendsGeometryChanges); // to keep the node index up-to-date
     setCacheMode(DeviceCoordinateCache);
     setAcceptHoverEvents(true);
 
     // create secondary items
     m_perimeter = new Perimeter(this);
     m_label = new NodeLabel(this);
+    CachePolicy& cachePolicy = m_scene->getCachePolicy();
+    cachePolicy.apply(this);
+    cachePolicy.apply(m_perimeter);
+    cachePolicy.apply(m_label);
 
     // initiate members influenced by styling
     updateStyle();
@@ -118,6 +130,7 @@ Plug *Node::createPlug(const QString& name, PlugDirection direction)
     // update the node repesentation to accomodate the new plug
     updateStyle();
 
+    emit m_scene->getSignalHub()->plugCreated(PlugHandle(newPlug));
     return newPlug;
 }
 
@@ -154,6 +167,7 @@ bool Node::removePlug(Plug *plug)
     }
 
     // remove the plug from the scene and memory
+    emit m_scene->getSignalHub()->plugRemoved(PlugHandle(plug));
     m_allPlugs.remove(plug->getName());
     scene()->removeItem(plug);
     plug->deleteLater();
@@ -175,15 +189,17 @@ Plug* Node::getClosestPlugTo(const QPointF& pos, PlugDirection direction)
         }
     }
 
-    // find and return the closest plug
+    // find and return the plug with the closest angle
+    qreal angle = qAtan2(pos.y(), pos.x());
+    qreal closestDistance = DBL_MAX;
     Plug* closest=nullptr;
     if(direction==PlugDirection::IN){
-        closest = findClosestPlug(pos, m_incomingPlugs, closest);
+        closest = findClosestPlug(angle, m_incomingPlugIndex, closest, closestDistance);
     } else { // OUT or BOTH
-        closest = findClosestPlug(pos, m_outgoingPlugs, closest);
+        closest = findClosestPlug(angle, m_outgoingPlugIndex, closest, closestDistance);
     }
     if(direction==PlugDirection::BOTH){
-        closest = findClosestPlug(pos, m_incomingPlugs, closest);
+        closest = findClosestPlug(angle, m_incomingPlugIndex, closest, closestDistance);
     }
     return closest;
 }
@@ -207,6 +223,7 @@ void Node::setDisplayName(const QString& displayName)
         edge->updateLabel();
     }
     emit nodeRenamed(m_displayName);
+    emit m_scene->getSignalHub()->nodeRenamed(NodeHandle(this), m_displayName);
 }
 
 QString Node::renamePlug(Plug *plug, const QString& newName)
@@ -268,6 +285,14 @@ bool Node::togglePlugDirection(Plug* plug)
     return true;
 }
 
+void Node::updateLabels()
+{
+    m_label->update();
+    for(Plug* plug : m_allPlugs){
+        plug->updateLabel();
+    }
+}
+
 void Node::updateStyle()
 {
     prepareGeometryChange();
@@ -302,16 +327,20 @@ QRectF Node::boundingRect() const
 
 void Node::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* /* widget */)
 {
+    m_scene->getCachePolicy().recordRender(CachedItem::NODE);
     painter->setClipRect(option->exposedRect);
 
     // draw the node a different color, if it is selected
-    if(isSelected()){
-        painter->setBrush(s_selectedColor);
-    } else {
-        painter->setBrush(s_idleColor);
+    const QColor& color = isSelected() ? s_selectedColor : s_idleColor;
+
+    // blit the core from the shared sprite, if possible
+    SpriteAtlas& spriteAtlas = m_scene->getSpriteAtlas();
+    if((spriteAtlas.isEnabled()) && (spriteAtlas.drawDisk(painter, s_coreRadius, color, s_linePen))){
+        return;
     }
 
     // draw core
+    painter->setBrush(color);
     painter->setPen(s_linePen);
     painter->drawEllipse(quadrat(s_coreRadius));
 }
@@ -362,23 +391,30 @@ void Node::mousePressEvent(QGraphicsSceneMouseEvent *event)
         // remove the node
         event->accept();
         emit removalRequested();
+        emit m_scene->getSignalHub()->nodeRemovalRequested(NodeHandle(this));
         return;
     }
 }
 
 void Node::mouseMoveEvent(QGraphicsSceneMouseEvent* event)
 {
-    // if this method is called, then the mouse is being dragged
-    s_mouseWasDragged = true;
+    // only the selection button drags nodes around
+    if(!(event->buttons() & View::getSelectionButton())){
+        s_mouseWasDragged = true;
+        QGraphicsObject::mouseMoveEvent(event);
+        return;
+    }
 
-    // update the edges of all selected nodes, including yourself
-    for(QGraphicsItem* selectedItem : scene()->selectedItems()){
-        Node* selectedNode = qobject_cast<Node*>(selectedItem->toGraphicsObject());
-        if(selectedNode){
-            selectedNode->updateConnectedEdges();
-        }
+    // collect all selected nodes into the drag layer once, when the drag starts
+    DragLayer* dragLayer = m_scene->getDragLayer();
+    if(!s_mouseWasDragged){
+        s_mouseWasDragged = true;
+        dragLayer->collect(this);
     }
-    QGraphicsObject::mouseMoveEvent(event);
+
+    // move the complete selection at once
+    event->accept();
+    dragLayer->setOffset(event->scenePos() - event->buttonDownScenePos(View::getSelectionButton()));
 }
 
 void Node::mouseReleaseEvent(QGraphicsSceneMouseEvent* event)
@@ -387,6 +423,11 @@ void Node::mouseReleaseEvent(QGraphicsSceneMouseEvent* event)
     if((event->button() == View::getSelectionButton()) && (!s_mouseWasDragged)){
         toggleExpansion();
     }
+
+    // commit the position of all dragged nodes
+    if(event->button() == View::getSelectionButton()){
+        m_scene->getDragLayer()->commit();
+    }
     QGraphicsObject::mouseReleaseEvent(event);
 }
 
@@ -408,13 +449,29 @@ void Node::keyPressEvent(QKeyEvent* event)
             Node* selectedNode = qobject_cast<Node*>(selectedItem->toGraphicsObject());
             if((selectedNode) && (selectedNode!=this)){
                 emit selectedNode->nodeActivated();
+                emit m_scene->getSignalHub()->nodeActivated(NodeHandle(selectedNode));
             }
         }
         emit nodeActivated(); // make sure that this node is activated last
+        emit m_scene->getSignalHub()->nodeActivated(NodeHandle(this));
     }
     QGraphicsObject::keyPressEvent(event);
 }
 
+QVariant Node::itemChange(GraphicsItemChange change, const QVariant& value)
+{
+    // while dragged, the node is moved through the drag layer and updated once the drag is committed
+    if((change==ItemPositionHasChanged) && (m_scene)){
+        m_scene->getNodeIndex().updateNode(this);
+        emit m_scene->getSignalHub()->nodeMoved(NodeHandle(this));
+    }
+    // keep the selection cache of the scene up to date
+    else if((change==ItemSelectedHasChanged) && (m_scene)){
+        m_scene->nodeSelectionHasChanged(this, value.toBool());
+    }
+    return QGraphicsObject::itemChange(change, value);
+}
+
 QString Node::getUniquePlugName(const QString& name, const Plug *plug)
 {
     // if the name is already unique, just return it
@@ -498,19 +555,6 @@ void Node::setExpansion(NodeExpansion newState)
     m_expansionState = newState;
 }
 
-void Node::updateConnectedEdges()
-{
-    // plugs
-    for(Plug* plug: m_allPlugs){
-        plug->updateEdges();
-    }
-
-    // straight edges
-    for(StraightEdge* straightEdge : m_straightEdges){
-        straightEdge->nodePositionHasChanged();
-    }
-}
-
 void Node::updateIncomingSpread(qreal expansion)
 {
     // store the new value
@@ -519,10 +563,13 @@ void Node::updateIncomingSpread(qreal expansion)
     // update the perimeter opacity
     m_perimeter->setOpacity(qMax(m_outgoingExpansionFactor, m_incomingExpansionFactor)*Perimeter::getMaxOpacity());
 
-    // update the plugs
+    // update the plugs and their edges
+    EdgeGeometryBuffer& edgeBuffer = m_scene->getEdgeGeometryBuffer();
     for(Plug* plug : m_incomingPlugs){
         plug->updateExpansion(m_incomingExpansionFactor);
+        edgeBuffer.addEdges(plug->getEdges());
     }
+    edgeBuffer.update();
 }
 
 void Node::updateOutgoingSpread(qreal expansion)
@@ -533,10 +580,13 @@ void Node::updateOutgoingSpread(qreal expansion)
     // update the perimeter opacity
     m_perimeter->setOpacity(qMax(m_outgoingExpansionFactor, m_incomingExpansionFactor)*Perimeter::getMaxOpacity());
 
-    // update the plugs
+    // update the plugs and their edges
+    EdgeGeometryBuffer& edgeBuffer = m_scene->getEdgeGeometryBuffer();
     for(Plug* plug : m_outgoingPlugs){
         plug->updateExpansion(m_outgoingExpansionFactor);
+        edgeBuffer.addEdges(plug->getEdges());
     }
+    edgeBuffer.update();
 }
 
 void Node::arrangePlugs()
@@ -544,6 +594,7 @@ void Node::arrangePlugs()
     // return early if there are no plugs to arrange
     int plugCount = m_allPlugs.size();
     if(plugCount==0){
+        updatePlugIndex();
         return;
     }
 
@@ -670,6 +721,26 @@ void Node::arrangePlugs()
         qreal angle = zoneDirections.at(optimalPath.at(plugIndex));
         plugs.at(plugIndex)->defineShape(QVector2D(qCos(angle), -qSin(angle)), plugSweepAngle);
     }
+
+    // the plugs have moved, so the index has to follow
+    updatePlugIndex();
+}
+
+void Node::updatePlugIndex()
+{
+    m_outgoingPlugIndex.clear();
+    m_incomingPlugIndex.clear();
+    for(Plug* plug : m_allPlugs){
+        QVector2D normal = plug->getNormal();
+        QPair<qreal, Plug*> entry(qAtan2(normal.y(), normal.x()), plug);
+        if(plug->getDirection()==PlugDirection::IN){
+            m_incomingPlugIndex.append(entry);
+        } else {
+            m_outgoingPlugIndex.append(entry);
+        }
+    }
+    std::sort(m_outgoingPlugIndex.begin(), m_outgoingPlugIndex.end());
+    std::sort(m_incomingPlugIndex.begin(), m_incomingPlugIndex.end());
 }
 
 qreal Node::getPlugAngle() const
@@ -694,6 +765,7 @@ void Node::adjustRadius()
     int plugCount = m_allPlugs.count();
     if(plugCount==0){
         m_perimeter->setRadius(0.); // resets the perimeter's radius to its minimal radius
+        m_scene->getNodeIndex().updateNode(this);
         return;
     }
 
@@ -706,17 +778,22 @@ void Node::adjustRadius()
             + (deadArcLength * 2);
     qreal radius = requiredArcLength/(2 * M_PI);
     m_perimeter->setRadius(radius); // perimeter does not shrink pass its minimal radius
+    m_scene->getNodeIndex().updateNode(this);
 
     //
     // update the shape and position of all plugs
+    EdgeGeometryBuffer& edgeBuffer = m_scene->getEdgeGeometryBuffer();
     for(Plug* plug : m_incomingPlugs){
         plug->defineShape(plug->getNormal(), getPlugAngle());
         plug->updateExpansion(m_incomingExpansionFactor);
+        edgeBuffer.addEdges(plug->getEdges());
     }
     for(Plug* plug : m_outgoingPlugs){
         plug->defineShape(plug->getNormal(), getPlugAngle());
         plug->updateExpansion(m_outgoingExpansionFactor);
+        edgeBuffer.addEdges(plug->getEdges());
     }
+    edgeBuffer.update();
 }
 
 void Node::updateOutlinePen()
@@ -724,6 +801,11 @@ void Node::updateOutlinePen()
     s_linePen = QPen(QBrush(s_outlineColor), s_outlineWidth);
 }
 
+int Node::type() const
+{
+    return itemType::NODE_TYPE;
+}
+
 } // namespace zodiac
 
 ///////////////////////////////////////////////////////////////////////////////////////////////////
@@ -757,38 +839,56 @@ static void fireAnimation(QPropertyAnimation& animation, qreal targetValue, qrea
 }
 
 ///
-/// \brief Finds the closest plug to a given coordiante.
+/// \brief Finds the plug with the closest angle to a given angle, using a binary search in an angle-sorted index.
 ///
 /// If the plug is an incoming one, it is only considered, if it doesn not have any edges connected yet.
 ///
-/// \param pos          Position from which to measure the distance.
-/// \param plugs        Vector of all potential plugs to search.
-/// \param closest      Currently closest plug, can be <i>nullptr</i>.
+/// \param angle            Angle from which to measure the distance.
+/// \param plugIndex        Plugs to search, sorted by the angle of their normal.
+/// \param closest          Currently closest plug, can be <i>nullptr</i>.
+/// \param closestDistance  [in/out] Angular distance of the currently closest plug, is updated if a closer one is found.
 ///
-/// \return             New closest plug or the one passed in.
+/// \return                 New closest plug or the one passed in.
 ///
-static zodiac::Plug* findClosestPlug(const QPointF& pos, const QSet<zodiac::Plug*> &plugs, zodiac::Plug* closest)
+static zodiac::Plug* findClosestPlug(qreal angle, const QVector<QPair<qreal, zodiac::Plug*>>& plugIndex,
+                                     zodiac::Plug* closest, qreal& closestDistance)
 {
-    // find current minimal distance
-    qreal minDistSq;
-    if(closest){
-        minDistSq = QVector2D((closest->getNormal()).toPointF()-pos).lengthSquared();
-    } else {
-        minDistSq = DBL_MAX;
-    }
-
-    // find closest plug to pos
-    for(zodiac::Plug* plug : plugs){
+    int plugCount = plugIndex.size();
+    if(plugCount==0){
+        return closest;
+    }
+
+    // find the first plug at or after the angle, the index wraps around at +/- pi
+    auto nextPlug = std::lower_bound(plugIndex.constBegin(), plugIndex.constEnd(), angle,
+                                     [](const QPair<qreal, zodiac::Plug*>& entry, qreal value){
+                                        return entry.first < value;});
+    int afterIndex = int(nextPlug-plugIndex.constBegin()) % plugCount;
+    int beforeIndex = (afterIndex+plugCount-1) % plugCount;
+
+    // walk outwards in both directions until a selectable plug is found on each side
+    bool isAfterFound = false;
+    bool isBeforeFound = false;
+    for(int step = 0; (step < plugCount) && !(isAfterFound && isBeforeFound); ++step){
+        for(int side = 0; side < 2; ++side){
+            bool& isFound = (side==0) ? isAfterFound : isBeforeFound;
+            if(isFound){
+                continue;
+            }
+            int index = (side==0) ? (afterIndex+step) % plugCount : (beforeIndex-step+plugCount) % plugCount;
+            const QPair<qreal, zodiac::Plug*>& entry = plugIndex.at(index);
 
-        // skip incoming plugs that already have an edge connected
-        if((plug->getDirection()==zodiac::PlugDirection::IN)&&(plug->getEdgeCount()>0)){
-            continue;
-        }
+            // skip incoming plugs that already have an edge connected
+            zodiac::Plug* plug = entry.second;
+            if((plug->getDirection()==zodiac::PlugDirection::IN)&&(plug->getEdgeCount()>0)){
+                continue;
+            }
 
-        qreal distSq = QVector2D((plug->getNormal()).toPointF()-pos).lengthSquared();
-        if(distSq < minDistSq){
-            minDistSq = distSq;
-            closest = plug;
+            isFound = true;
+            qreal distance = angularDistance(angle, entry.first);
+            if(distance < closestDistance){
+                closestDistance = distance;
+                closest = plug;
+            }
         }
     }
     return closest;
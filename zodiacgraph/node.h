@@ -32,12 +32,16 @@
 ///
 
 #include <QGraphicsObject>
+#include <QHash>
 #include <QPropertyAnimation>
 #include <QSet>
 #include <QUuid>
+#include <QVector>
 
 namespace zodiac {
 
+class DragLayer;
+class EdgeGroupPair;
 class NodeLabel;
 class Perimeter;
 class Plug;
@@ -183,11 +187,63 @@ public: // methods
     inline void removeStraightEdge(StraightEdge* edge) {Q_ASSERT(m_straightEdges.contains(edge));
                                                         m_straightEdges.remove(edge);}
 
+    ///
+    /// \brief All StraightEdge%s connected to this Node, including StraightDoubleEdge%s.
+    ///
+    /// \return This Node's straight edges.
+    ///
+    inline const QSet<StraightEdge*>& getStraightEdges() const {return m_straightEdges;}
+
+    ///
+    /// \brief Registers the EdgeGroupPair connecting this Node with a neighbor.
+    ///
+    /// Is called by the Scene, when the first PlugEdge between the two Node%s is created.
+    ///
+    /// \param [in] neighbor    Node connected to this Node.
+    /// \param [in] pair        EdgeGroupPair managing all PlugEdge%s between the two Node%s.
+    ///
+    inline void addEdgeGroupPair(Node* neighbor, EdgeGroupPair* pair) {m_edgeGroupPairs.insert(neighbor, pair);}
+
+    ///
+    /// \brief Unregisters the EdgeGroupPair connecting this Node with a neighbor.
+    ///
+    /// Is called by the Scene, when the last PlugEdge between the two Node%s is removed.
+    ///
+    /// \param [in] neighbor    Node that is no longer connected to this Node.
+    ///
+    inline void removeEdgeGroupPair(Node* neighbor) {Q_ASSERT(m_edgeGroupPairs.contains(neighbor));
+                                                     m_edgeGroupPairs.remove(neighbor);}
+
+    ///
+    /// \brief The EdgeGroupPair connecting this Node with a neighbor.
+    ///
+    /// \param [in] neighbor    Other Node.
+    ///
+    /// \return                 The EdgeGroupPair between the two Node%s or <i>nullptr</i>, if they are not connected.
+    ///
+    inline EdgeGroupPair* getEdgeGroupPair(Node* neighbor) const {return m_edgeGroupPairs.value(neighbor, nullptr);}
+
+    ///
+    /// \brief All Node%s connected to this Node through at least one PlugEdge, in either direction.
+    ///
+    /// \return Neighbors of this Node.
+    ///
+    inline QList<Node*> getNeighbors() const {return m_edgeGroupPairs.keys();}
+
+    ///
+    /// \brief All EdgeGroupPair%s connecting this Node with its neighbors.
+    ///
+    /// \return EdgeGroupPair%s of this Node.
+    ///
+    inline QList<EdgeGroupPair*> getEdgeGroupPairs() const {return m_edgeGroupPairs.values();}
+
     ///
     /// \brief Returns the Plug closest to a position within the Node or its Perimeter.
     ///
     /// The method takes a second parameter to limit the search to incoming / outgoing nodes or include both.
     /// If incoming Plug%s are requested, only those without an existing connection are considered.
+    /// The closest Plug is the one whose normal is angularly closest to the position, it is found with a binary search
+    /// in an index of Plug%s sorted by angle, which is rebuilt whenever the Plug%s are arranged.
     ///
     /// \param [in] pos         Position from which to calculate the nearest Plug, in coordinates local to this Node.
     /// \param [in] direction   Direction of the requested Plug%s, can also be PlugDirection::BOTH.
@@ -348,6 +404,20 @@ public: // methods
     ///
     void updateStyle();
 
+    ///
+    /// \brief Repaints the NodeLabel and the labels of all Plug%s of this Node, discarding their item caches.
+    ///
+    /// Is called by the Scene, when its labels are shown or hidden.
+    ///
+    void updateLabels();
+
+    ///
+    /// \brief Custom QGraphicsItem type of the Node, used by the CachePolicy of the Scene.
+    ///
+    /// \return The type of this item.
+    ///
+    int type() const;
+
 signals:
 
     ///
@@ -623,7 +693,7 @@ protected: // methods
     ///
     /// \brief Called, when the mouse is moved after clicking on the item.
     ///
-    /// Updates all connected plugs' edges.
+    /// Moves all selected Node%s together through the Scene's DragLayer.
     /// Also works if the node is dragged outside the view.
     ///
     /// \param [in] event   Qt event object.
@@ -635,6 +705,7 @@ protected: // methods
     ///
     /// Is always called after \ref zodiac::Node::mousePressEvent "mousePressEvent" and possibly
     /// \ref zodiac::Node::mouseMoveEvent "mouseMoveEvent".
+    /// Commits the new positions of all dragged Node%s.
     ///
     /// \param [in] event   Qt event object.
     ///
@@ -654,6 +725,18 @@ protected: // methods
     ///
     void keyPressEvent(QKeyEvent* event);
 
+    ///
+    /// \brief Called when the state of the item changes.
+    ///
+    /// Keeps the Scene's NodeIndex up-to-date when the Node is moved.
+    ///
+    /// \param [in] change  Type of the change.
+    /// \param [in] value   New value of the changed state.
+    ///
+    /// \return             Value to use for the change.
+    ///
+    QVariant itemChange(GraphicsItemChange change, const QVariant& value);
+
 private: // methods
 
     ///
@@ -700,11 +783,6 @@ private: // methods
     ///
     inline void resetExpansion() {setExpansion(m_lastExpansionState);}
 
-    ///
-    /// \brief Updates all edges connecting to any Plug of this Node.
-    ///
-    void updateConnectedEdges();
-
     ///
     /// \brief Called by the incoming expansion and collapse-animations to update the spread factor of incoming Plug%s.
     ///
@@ -726,6 +804,14 @@ private: // methods
     ///
     void arrangePlugs();
 
+    ///
+    /// \brief Rebuilds the angle-sorted indices of incoming and outgoing Plug%s.
+    ///
+    /// Is called whenever the Plug%s have been arranged anew, the index is used to find the closest Plug to a position
+    /// with a binary search.
+    ///
+    void updatePlugIndex();
+
     ///
     /// \brief The sweep angle of a Plug of this Node in radians.
     ///
@@ -828,11 +914,26 @@ private: // members
     ///
     QSet<Plug*> m_incomingPlugs;
 
+    ///
+    /// \brief All outgoing Plug%s of this Node, sorted by the angle of their normal.
+    ///
+    QVector<QPair<qreal, Plug*>> m_outgoingPlugIndex;
+
+    ///
+    /// \brief All incoming Plug%s of this Node, sorted by the angle of their normal.
+    ///
+    QVector<QPair<qreal, Plug*>> m_incomingPlugIndex;
+
     ///
     /// \brief All StraightEdge%s connected to this Node.
     ///
     QSet<StraightEdge*> m_straightEdges;
 
+    ///
+    /// \brief The EdgeGroupPair%s connecting this Node with each of its neighbors.
+    ///
+    QHash<Node*, EdgeGroupPair*> m_edgeGroupPairs;
+
     ///
     /// \brief The NodeLabel of this Node.
     ///
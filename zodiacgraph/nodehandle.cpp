@@ -8,30 +8,17 @@
 namespace zodiac {
 
 NodeHandle::NodeHandle(Node* node)
-    : QObject(nullptr)
-    , m_node(node)
-    , m_isValid(node!=nullptr)
+    : m_node(node)
+    , m_reference(node)
 {
-    connectSignals();
-}
-
-NodeHandle& NodeHandle::operator = (const NodeHandle& other)
-{
-    if(m_node){
-        m_node->disconnect(this);
-    }
-    m_node = other.data();
-    m_isValid = m_node != nullptr;
-    connectSignals();
-    return *this;
 }
 
 bool NodeHandle::isRemovable() const
 {
 #ifdef QT_DEBUG
-    Q_ASSERT(m_isValid);
+    Q_ASSERT(isValid());
 #else
-    if(!m_isValid){
+    if(!isValid()){
         return false;
     }
 #endif
@@ -41,14 +28,14 @@ bool NodeHandle::isRemovable() const
 bool NodeHandle::remove()
 {
 #ifdef QT_DEBUG
-    Q_ASSERT(m_isValid);
+    Q_ASSERT(isValid());
 #else
-    if(!m_isValid){
+    if(!isValid()){
         return false;
     }
 #endif
     if(m_node->getScene()->removeNode(m_node)){
-        m_isValid = false;
+        m_reference.clear();
         return true;
     } else {
         return false;
@@ -58,9 +45,9 @@ bool NodeHandle::remove()
 const QUuid& NodeHandle::getId() const
 {
 #ifdef QT_DEBUG
-    Q_ASSERT(m_isValid);
+    Q_ASSERT(isValid());
 #else
-    if(!m_isValid){
+    if(!isValid()){
         QUuid();
     }
 #endif
@@ -70,9 +57,9 @@ const QUuid& NodeHandle::getId() const
 QString NodeHandle::getName() const
 {
 #ifdef QT_DEBUG
-    Q_ASSERT(m_isValid);
+    Q_ASSERT(isValid());
 #else
-    if(!m_isValid){
+    if(!isValid()){
         return "";
     }
 #endif
@@ -82,9 +69,9 @@ QString NodeHandle::getName() const
 void NodeHandle::rename(const QString& name)
 {
 #ifdef QT_DEBUG
-    Q_ASSERT(m_isValid);
+    Q_ASSERT(isValid());
 #else
-    if(!m_isValid){
+    if(!isValid()){
         return;
     }
 #endif
@@ -94,9 +81,9 @@ void NodeHandle::rename(const QString& name)
 PlugHandle NodeHandle::createIncomingPlug(const QString& name)
 {
 #ifdef QT_DEBUG
-    Q_ASSERT(m_isValid);
+    Q_ASSERT(isValid());
 #else
-    if(!m_isValid){
+    if(!isValid()){
         PlugHandle();
     }
 #endif
@@ -106,9 +93,9 @@ PlugHandle NodeHandle::createIncomingPlug(const QString& name)
 PlugHandle NodeHandle::createOutgoingPlug(const QString& name)
 {
 #ifdef QT_DEBUG
-    Q_ASSERT(m_isValid);
+    Q_ASSERT(isValid());
 #else
-    if(!m_isValid){
+    if(!isValid()){
         PlugHandle();
     }
 #endif
@@ -119,9 +106,9 @@ QList<PlugHandle> NodeHandle::getPlugs() const
 {
     QList<PlugHandle> result;
 #ifdef QT_DEBUG
-    Q_ASSERT(m_isValid);
+    Q_ASSERT(isValid());
 #else
-    if(!m_isValid){
+    if(!isValid()){
         return result;
     }
 #endif
@@ -136,21 +123,39 @@ QList<PlugHandle> NodeHandle::getPlugs() const
 PlugHandle NodeHandle::getPlug(const QString& name) const
 {
 #ifdef QT_DEBUG
-    Q_ASSERT(m_isValid);
+    Q_ASSERT(isValid());
 #else
-    if(!m_isValid){
+    if(!isValid()){
         return PlugHandle();
     }
 #endif
     return PlugHandle(m_node->getPlug(name));
 }
 
+QList<NodeHandle> NodeHandle::getNeighbors() const
+{
+    QList<NodeHandle> result;
+#ifdef QT_DEBUG
+    Q_ASSERT(isValid());
+#else
+    if(!isValid()){
+        return result;
+    }
+#endif
+    QList<Node*> neighbors = m_node->getNeighbors();
+    result.reserve(neighbors.size());
+    for(Node* neighbor : neighbors){
+        result.append(NodeHandle(neighbor));
+    }
+    return result;
+}
+
 void NodeHandle::setSelected(bool isSelected)
 {
 #ifdef QT_DEBUG
-    Q_ASSERT(m_isValid);
+    Q_ASSERT(isValid());
 #else
-    if(!m_isValid){
+    if(!isValid()){
         return;
     }
 #endif
@@ -160,9 +165,9 @@ void NodeHandle::setSelected(bool isSelected)
 SceneHandle NodeHandle::getScene() const
 {
 #ifdef QT_DEBUG
-    Q_ASSERT(m_isValid);
+    Q_ASSERT(isValid());
 #else
-    if(!m_isValid){
+    if(!isValid()){
         return SceneHandle();
     }
 #endif
@@ -172,9 +177,9 @@ SceneHandle NodeHandle::getScene() const
 QPointF NodeHandle::getPos() const
 {
 #ifdef QT_DEBUG
-    Q_ASSERT(m_isValid);
+    Q_ASSERT(isValid());
 #else
-    if(!m_isValid){
+    if(!isValid()){
         return QPointF();
     }
 #endif
@@ -184,69 +189,13 @@ QPointF NodeHandle::getPos() const
 void NodeHandle::setPos(qreal x, qreal y)
 {
 #ifdef QT_DEBUG
-    Q_ASSERT(m_isValid);
+    Q_ASSERT(isValid());
 #else
-    if(!m_isValid){
+    if(!isValid()){
         return;
     }
 #endif
     m_node->setPos(x, y);
 }
 
-void NodeHandle::connectSignals()
-{
-    if(!m_isValid){
-        return;
-    }
-    connect(m_node, SIGNAL(destroyed()), this, SLOT(nodeWasDestroyed()));
-    connect(m_node, SIGNAL(nodeActivated()), this, SIGNAL(nodeActivated()));
-    connect(m_node, SIGNAL(nodeRenamed(QString)), this, SIGNAL(nodeRenamed(QString)));
-    connect(m_node, SIGNAL(removalRequested()), this, SIGNAL(removalRequested()));
-    connect(m_node, SIGNAL(inputConnected(Plug*,Plug*)), this, SLOT(passInputConnected(Plug*,Plug*)));
-    connect(m_node, SIGNAL(inputDisconnected(Plug*,Plug*)), this, SLOT(passInputDisconnected(Plug*,Plug*)));
-    connect(m_node, SIGNAL(outputConnected(Plug*,Plug*)), this, SLOT(passOutputConnected(Plug*,Plug*)));
-    connect(m_node, SIGNAL(outputDisconnected(Plug*,Plug*)), this, SLOT(passOutputDisconnected(Plug*,Plug*)));
-}
-
-void NodeHandle::passInputConnected(Plug* myInput, Plug* otherOutput)
-{
-#ifdef QT_DEBUG
-    Q_ASSERT(m_isValid);
-#endif
-    emit inputConnected(PlugHandle(myInput), PlugHandle(otherOutput));
-}
-
-void NodeHandle::passOutputConnected(Plug* myOutput, Plug* otherInput)
-{
-#ifdef QT_DEBUG
-    Q_ASSERT(m_isValid);
-#endif
-    emit outputConnected(PlugHandle(myOutput), PlugHandle(otherInput));
-}
-
-void NodeHandle::passInputDisconnected(Plug* myInput, Plug* otherOutput)
-{
-#ifdef QT_DEBUG
-    Q_ASSERT(m_isValid);
-#endif
-    emit inputDisconnected(PlugHandle(myInput), PlugHandle(otherOutput));
-}
-
-void NodeHandle::passOutputDisconnected(Plug* myOutput, Plug* otherInput)
-{
-#ifdef QT_DEBUG
-    Q_ASSERT(m_isValid);
-#endif
-    emit outputDisconnected(PlugHandle(myOutput), PlugHandle(otherInput));
-}
-
-void NodeHandle::nodeWasDestroyed()
-{
-#ifdef QT_DEBUG
-    Q_ASSERT(m_isValid);
-#endif
-    m_isValid = false;
-    this->disconnect();
-}
-
 } // namespace zodiac
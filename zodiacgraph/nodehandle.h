@@ -31,8 +31,9 @@
 /// \brief Contains the definition of the zodiac::NodeHandle class.
 ///
 
-#include <QObject>
 #include <QHash>
+#include <QMetaType>
+#include <QPointer>
 
 #include "plughandle.h"
 
@@ -49,11 +50,12 @@ class SceneHandle;
 ///
 /// See \ref zodiac::SceneHandle "SceneHandle" for more details on handles.
 ///
-class NodeHandle : public QObject
+/// NodeHandle%s are cheap values, which can be copied and stored in large numbers.
+/// They do not emit signals by themselves, all notifications about Node%s are emitted by the SignalHub of the Scene.
+///
+class NodeHandle
 {
 
-    Q_OBJECT
-
 public: // methods
 
     ///
@@ -68,8 +70,7 @@ public: // methods
     ///
     /// \param [in] other   Other NodeHandle to copy.
     ///
-    NodeHandle(const NodeHandle& other)
-        : NodeHandle(other.data()) {}
+    NodeHandle(const NodeHandle& other) = default;
 
     ///
     /// \brief Assignment operator.
@@ -78,7 +79,7 @@ public: // methods
     ///
     /// \return             This.
     ///
-    NodeHandle& operator = (const NodeHandle& other);
+    NodeHandle& operator = (const NodeHandle& other) = default;
 
     ///
     /// \brief Equality operator.
@@ -101,7 +102,7 @@ public: // methods
     ///
     /// \return <i>true</i>, if the NodeHandle is still managing an existing Node -- <i>false</i> otherwise.
     ///
-    inline bool isValid() const {return m_isValid;}
+    inline bool isValid() const {return !m_reference.isNull();}
 
     ///
     /// \brief Only Node%s with no connections can be removed.
@@ -172,6 +173,13 @@ public: // methods
     ///
     PlugHandle getPlug(const QString& name) const;
 
+    ///
+    /// \brief Returns handles for all Nodes connected to the managed Node through at least one edge.
+    ///
+    /// \return All neighbors of the managed Node, regardless of the direction of their edges.
+    ///
+    QList<NodeHandle> getNeighbors() const;
+
     ///
     /// \brief setSelected
     ///
@@ -201,117 +209,21 @@ public: // methods
     ///
     void setPos(qreal x, qreal y);
 
-signals:
-
-    ///
-    /// \brief Emitted, when the \ref zodiac::View::s_activationKey "activation key" is pressed while the managed Node
-    /// is selected.
-    ///
-    void nodeActivated();
-
-    ///
-    /// \brief Emitted, when the display name of the Node was changed.
-    ///
-    /// \param [out] name   New display name of the Node.
-    ///
-    void nodeRenamed(const QString& name);
-
-    ///
-    /// \brief Emitted, when the \ref zodiac::View::s_removalButton "removal button" is pressed on the managed Node.
-    ///
-    void removalRequested();
-
-    ///
-    /// \brief Is emitted, when an incoming plug of the managed Node has been connected to an outgoing plug of another
-    /// Node.
-    ///
-    /// \param [out] myInput        The input plug of the managed Node.
-    /// \param [out] otherOutput    The output plug of the source Node.
-    ///
-    void inputConnected(zodiac::PlugHandle myInput, zodiac::PlugHandle otherOutput);
-
-    ///
-    /// \brief Is emitted, when an outgoing plug of the managed Node has been connected to an incoming plug of another
-    /// Node.
-    ///
-    /// \param [out] myOutput   The output plug of the managed Node.
-    /// \param [out] otherInput The input plug of the target Node.
-    ///
-    void outputConnected(zodiac::PlugHandle myOutput, zodiac::PlugHandle otherInput);
-
-    ///
-    /// \brief Is emitted, when a connection from an incoming plug of the managed Node was removed.
-    ///
-    /// \param [out] myInput        The input plug of the managed Node.
-    /// \param [out] otherOutput    The output plug of the source Node.
-    ///
-    void inputDisconnected(zodiac::PlugHandle myInput, zodiac::PlugHandle otherOutput);
-
-    ///
-    /// \brief Is emitted, when a connection from an outgoing plug of the managed Node was removed.
-    ///
-    /// \param [out] myOutput   The output plug of the managed Node.
-    /// \param [out] otherInput The input plug of the target Node.
-    ///
-    void outputDisconnected(zodiac::PlugHandle myOutput, zodiac::PlugHandle otherInput);
-
-private: // methods
-
-    ///
-    /// \brief Connects the handle to its managed object.
-    ///
-    void connectSignals();
-
-private slots:
-
-    ///
-    /// \brief Passes the 'inputConnected'-signal from the managed Node.
-    ///
-    /// \param [in] myInput     The input Plug of the managed Node.
-    /// \param [in] otherOutput The output Plug of the source Node.
-    ///
-    void passInputConnected(Plug* myInput, Plug* otherOutput);
-
-    ///
-    /// \brief Passes the 'outputConnected'-signal from the managed Node.
-    ///
-    /// \param [in] myOutput    The output Plug of the managed Node.
-    /// \param [in] otherInput  The input Plug of the target Node.
-    ///
-    void passOutputConnected(Plug* myOutput, Plug* otherInput);
-
-    ///
-    /// \brief Passes the 'inputDisconnected'-signal from the managed Node.
-    ///
-    /// \param [in] myInput     The input Plug of the managed Node.
-    /// \param [in] otherOutput The output Plug of the source Node.
-    ///
-    void passInputDisconnected(Plug* myInput, Plug* otherOutput);
-
-    ///
-    /// \brief Passes the 'outputDisconnected'-signal from the managed Node.
-    ///
-    /// \param [in] myOutput    The output Plug of the managed Node.
-    /// \param [in] otherInput  The input Plug of the target Node.
-    ///
-    void passOutputDisconnected(Plug* myOutput, Plug* otherInput);
-
-    ///
-    /// \brief Called, when the mangaged Node was destroyed.
-    ///
-    void nodeWasDestroyed();
-
 private: // member
 
     ///
     /// \brief Managed node.
     ///
+    /// Identifies the handle and is never changed or set to <i>nullptr</i>, even after the Node was deleted.
+    ///
     Node* m_node;
 
     ///
-    /// \brief Validity flag.
+    /// \brief Weak reference to the managed node.
+    ///
+    /// Is automatically reset, when the Node is destroyed and cleared, when it is removed through this handle.
     ///
-    bool m_isValid;
+    QPointer<Node> m_reference;
 
 };
 
@@ -332,4 +244,6 @@ inline uint qHash(const zodiac::NodeHandle& key)
     return qHash(size_t(key.data()));
 }
 
+Q_DECLARE_METATYPE(zodiac::NodeHandle)
+
 #endif // ZODIAC_NODEHANDLE_H
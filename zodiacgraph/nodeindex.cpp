@@ -0,0 +1,266 @@
+#include "nodeindex.h"
+
+#include <QtMath>
+#include <cfloat> // for DBL_MAX
+
+#include "node.h"
+#include "utils.h"
+
+static inline qreal getSquaredDistance(const QPointF& a, const QPointF& b);
+
+namespace zodiac {
+
+qreal NodeIndex::s_cellSize = 256.;
+
+NodeIndex::NodeIndex()
+    : m_cellSize(s_cellSize)
+    , m_entries(QHash<Node*, Entry>())
+    , m_cells(QHash<qint64, QSet<Node*>>())
+    , m_radii(QMap<qreal, int>())
+{
+}
+
+void NodeIndex::addNode(Node* node)
+{
+#ifdef QT_DEBUG
+    Q_ASSERT(node);
+    Q_ASSERT(!m_entries.contains(node));
+#else
+    if((!node) || (m_entries.contains(node))){
+        return;
+    }
+#endif
+
+    Entry entry;
+    entry.center = node->scenePos();
+    entry.radius = node->getPerimeterRadius();
+    entry.cells = getCellsOf(quadrat(entry.radius).translated(entry.center));
+    registerNode(node, entry.cells, true);
+    registerRadius(entry.radius, true);
+    m_entries.insert(node, entry);
+}
+
+void NodeIndex::removeNode(Node* node)
+{
+    QHash<Node*, Entry>::iterator it = m_entries.find(node);
+    if(it==m_entries.end()){
+        return;
+    }
+    registerNode(node, it->cells, false);
+    registerRadius(it->radius, false);
+    m_entries.erase(it);
+}
+
+void NodeIndex::clear()
+{
+    m_entries.clear();
+    m_cells.clear();
+    m_radii.clear();
+}
+
+void NodeIndex::updateNode(Node* node)
+{
+    QHash<Node*, Entry>::iterator it = m_entries.find(node);
+    if(it==m_entries.end()){
+        return;
+    }
+
+    it->center = node->scenePos();
+    qreal radius = node->getPerimeterRadius();
+    if(radius!=it->radius){
+        registerRadius(it->radius, false);
+        registerRadius(radius, true);
+        it->radius = radius;
+    }
+
+    // only touch the grid if the node moved into a different range of cells
+    QRect cells = getCellsOf(quadrat(it->radius).translated(it->center));
+    if(cells==it->cells){
+        return;
+    }
+    registerNode(node, it->cells, false);
+    registerNode(node, cells, true);
+    it->cells = cells;
+}
+
+Node* NodeIndex::getNodeAt(const QPointF& pos, Node* ignore) const
+{
+    QPoint cell = getCellOf(pos);
+    QHash<qint64, QSet<Node*>>::const_iterator cellIt = m_cells.constFind(gridCellKey(cell.x(), cell.y()));
+    if(cellIt==m_cells.constEnd()){
+        return nullptr;
+    }
+
+    // every node covering the position is registered in its cell
+    Node* closestNode = nullptr;
+    qreal closestDistance = DBL_MAX;
+    for(Node* node : cellIt.value()){
+        if(node==ignore){
+            continue;
+        }
+        const Entry& entry = m_entries[node];
+        qreal distance = getSquaredDistance(pos, entry.center);
+        if((distance<=entry.radius*entry.radius) && (distance<closestDistance)){
+            closestNode = node;
+            closestDistance = distance;
+        }
+    }
+    return closestNode;
+}
+
+Node* NodeIndex::getNearestNode(const QPointF& pos) const
+{
+    if(m_entries.isEmpty()){
+        return nullptr;
+    }
+
+    // search rings of cells around the position, until no closer node can be found outside the current ring
+    static const int maxRingCount = 16;
+    QPoint origin = getCellOf(pos);
+    Node* closestNode = nullptr;
+    qreal closestDistance = DBL_MAX;
+    for(int ring = 0; ring <= maxRingCount; ++ring){
+        for(int y = origin.y()-ring; y <= origin.y()+ring; ++y){
+            bool isEdgeRow = (y==origin.y()-ring) || (y==origin.y()+ring);
+            int step = isEdgeRow ? 1 : qMax(1, ring*2);
+            for(int x = origin.x()-ring; x <= origin.x()+ring; x += step){
+                QHash<qint64, QSet<Node*>>::const_iterator cellIt = m_cells.constFind(gridCellKey(x, y));
+                if(cellIt==m_cells.constEnd()){
+                    continue;
+                }
+                for(Node* node : cellIt.value()){
+                    const Entry& entry = m_entries[node];
+                    qreal distance = getSquaredDistance(pos, entry.center);
+                    if(distance<closestDistance){
+                        closestNode = node;
+                        closestDistance = distance;
+                    }
+                }
+            }
+        }
+
+        // every unvisited cell is at least a ring's width away from the position
+        if((closestNode) && (closestDistance <= (ring*m_cellSize)*(ring*m_cellSize))){
+            return closestNode;
+        }
+    }
+
+    // fall back to a linear scan for sparse scenes
+    for(QHash<Node*, Entry>::const_iterator it = m_entries.constBegin(); it != m_entries.constEnd(); ++it){
+        qreal distance = getSquaredDistance(pos, it->center);
+        if(distance<closestDistance){
+            closestNode = it.key();
+            closestDistance = distance;
+        }
+    }
+    return closestNode;
+}
+
+QList<Node*> NodeIndex::getNodesInRect(const QRectF& rect, qreal radius) const
+{
+    QList<Node*> result;
+    QRectF normalizedRect = rect.normalized();
+    qreal maxRadius = radius;
+    if(maxRadius<0.){
+        maxRadius = m_radii.isEmpty() ? 0. : m_radii.lastKey();
+    }
+    QRect cells = getCellsOf(normalizedRect.adjusted(-maxRadius, -maxRadius, maxRadius, maxRadius));
+
+    // for large rects, it is cheaper to test all nodes directly than to visit every cell
+    QSet<Node*> candidates;
+    if(qint64(cells.width())*qint64(cells.height()) > m_entries.size()){
+        candidates.reserve(m_entries.size());
+        for(QHash<Node*, Entry>::const_iterator it = m_entries.constBegin(); it != m_entries.constEnd(); ++it){
+            candidates.insert(it.key());
+        }
+    } else {
+        for(int y = cells.top(); y <= cells.bottom(); ++y){
+            for(int x = cells.left(); x <= cells.right(); ++x){
+                QHash<qint64, QSet<Node*>>::const_iterator cellIt = m_cells.constFind(gridCellKey(x, y));
+                if(cellIt!=m_cells.constEnd()){
+                    candidates.unite(cellIt.value());
+                }
+            }
+        }
+    }
+
+    // circle-rectangle intersection test
+    for(Node* node : candidates){
+        const Entry& entry = m_entries[node];
+        qreal nodeRadius = radius<0. ? entry.radius : radius;
+        qreal closestX = qBound(normalizedRect.left(), entry.center.x(), normalizedRect.right());
+        qreal closestY = qBound(normalizedRect.top(), entry.center.y(), normalizedRect.bottom());
+        if(getSquaredDistance(entry.center, QPointF(closestX, closestY)) <= nodeRadius*nodeRadius){
+            result.append(node);
+        }
+    }
+    return result;
+}
+
+QPoint NodeIndex::getCellOf(const QPointF& pos) const
+{
+    return QPoint(qFloor(pos.x()/m_cellSize), qFloor(pos.y()/m_cellSize));
+}
+
+QRect NodeIndex::getCellsOf(const QRectF& rect) const
+{
+    return QRect(getCellOf(rect.topLeft()), getCellOf(rect.bottomRight()));
+}
+
+void NodeIndex::registerNode(Node* node, const QRect& cells, bool insert)
+{
+    for(int y = cells.top(); y <= cells.bottom(); ++y){
+        for(int x = cells.left(); x <= cells.right(); ++x){
+            qint64 key = gridCellKey(x, y);
+            if(insert){
+                m_cells[key].insert(node);
+            } else {
+                QHash<qint64, QSet<Node*>>::iterator cellIt = m_cells.find(key);
+                if(cellIt==m_cells.end()){
+                    continue;
+                }
+                cellIt->remove(node);
+                if(cellIt->isEmpty()){
+                    m_cells.erase(cellIt);
+                }
+            }
+        }
+    }
+}
+
+void NodeIndex::registerRadius(qreal radius, bool insert)
+{
+    if(insert){
+        ++m_radii[radius];
+        return;
+    }
+    QMap<qreal, int>::iterator radiusIt = m_radii.find(radius);
+    if(radiusIt==m_radii.end()){
+        return;
+    }
+    if(--radiusIt.value()==0){
+        m_radii.erase(radiusIt);
+    }
+}
+
+} // namespace zodiac
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// HELPER
+//
+
+///
+/// \brief Calculates the squared distance between two points.
+///
+/// \param a       First point.
+/// \param b       Second point.
+///
+/// \return        Squared distance between the two points.
+///
+static inline qreal getSquaredDistance(const QPointF& a, const QPointF& b)
+{
+    qreal dx = a.x()-b.x();
+    qreal dy = a.y()-b.y();
+    return dx*dx + dy*dy;
+}
@@ -0,0 +1,231 @@
+//
+//    ZodiacGraph - A general-purpose, circular node graph UI module.
+//    Copyright (C) 2015  Clemens Sielaff
+//
+//    The MIT License
+//
+//    Permission is hereby granted, free of charge, to any person obtaining a copy of
+//    this software and associated documentation files (the "Software"), to deal in
+//    the Software without restriction, including without limitation the rights to
+//    use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+//    of the Software, and to permit persons to whom the Software is furnished to do so,
+//    subject to the following conditions:
+//
+//    The above copyright notice and this permission notice shall be included in all
+//    copies or substantial portions of the Software.
+//
+//    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//    SOFTWARE.
+//
+
+#ifndef ZODIAC_NODEINDEX_H
+#define ZODIAC_NODEINDEX_H
+
+///
+/// \file nodeindex.h
+///
+/// \brief Contains the definition of the zodiac::NodeIndex class.
+///
+
+#include <QHash>
+#include <QList>
+#include <QMap>
+#include <QPoint>
+#include <QPointF>
+#include <QRect>
+#include <QRectF>
+#include <QSet>
+
+namespace zodiac {
+
+class Node;
+
+///
+/// \brief Spatial index of all Node%s in a Scene, storing their center and Perimeter radius in a uniform grid.
+///
+/// Finding a Node through QGraphicsScene::items() returns every item at a position -- edges, labels, Plug%s and all --
+/// which then have to be traced back to their Node.
+/// The NodeIndex only contains Node%s and answers point, rectangle and nearest-neighbor queries by only looking at the
+/// grid cells in question.
+///
+/// Each Node is registered in all cells that are covered by the bounding square of its Perimeter.
+/// The Scene keeps the index up-to-date when a Node is added, removed, moved or changes its radius.
+/// While Node%s are dragged around as part of the DragLayer, the index is only updated when the drag is finished.
+///
+class NodeIndex
+{
+
+public: // methods
+
+    ///
+    /// \brief Constructor.
+    ///
+    NodeIndex();
+
+    ///
+    /// \brief Adds a new Node to the index.
+    ///
+    /// \param [in] node    Node to add.
+    ///
+    void addNode(Node* node);
+
+    ///
+    /// \brief Removes a Node from the index.
+    ///
+    /// \param [in] node    Node to remove.
+    ///
+    void removeNode(Node* node);
+
+    ///
+    /// \brief Removes all Node%s from the index.
+    ///
+    void clear();
+
+    ///
+    /// \brief Updates the position and radius of a Node in the index.
+    ///
+    /// Does nothing, if the Node is not part of the index.
+    ///
+    /// \param [in] node    Node to update.
+    ///
+    void updateNode(Node* node);
+
+    ///
+    /// \brief Finds the Node whose Perimeter contains the given position.
+    ///
+    /// If multiple Node%s overlap at the position, the one with the closest center is returned.
+    ///
+    /// \param [in] pos     Position in scene coordinates.
+    /// \param [in] ignore  (optional) Node to ignore, can be <i>nullptr</i>.
+    ///
+    /// \return             Node at the position or <i>nullptr</i>, if there is none.
+    ///
+    Node* getNodeAt(const QPointF& pos, Node* ignore = nullptr) const;
+
+    ///
+    /// \brief Finds the Node with the closest center to the given position.
+    ///
+    /// \param [in] pos     Position in scene coordinates.
+    ///
+    /// \return             The nearest Node or <i>nullptr</i>, if the index is empty.
+    ///
+    Node* getNearestNode(const QPointF& pos) const;
+
+    ///
+    /// \brief Finds all Node%s whose circle intersects with the given rectangle.
+    ///
+    /// \param [in] rect    Rectangle in scene coordinates.
+    /// \param [in] radius  (optional) Radius of the circle around each Node center, if negative, the radius of each
+    ///                     Node's Perimeter is used.
+    ///
+    /// \return             All Node%s intersecting the rectangle.
+    ///
+    QList<Node*> getNodesInRect(const QRectF& rect, qreal radius = -1.) const;
+
+public: // static methods
+
+    ///
+    /// \brief The side length of a grid cell.
+    ///
+    /// \return Grid cell size in pixels.
+    ///
+    static inline qreal getCellSize() {return s_cellSize;}
+
+    ///
+    /// \brief Sets a new side length of a grid cell.
+    ///
+    /// Only affects NodeIndex instances created afterwards.
+    ///
+    /// \param [in] size    New grid cell size in pixels, must be larger than zero.
+    ///
+    static inline void setCellSize(qreal size) {s_cellSize=qMax(1., size);}
+
+private: // methods
+
+    ///
+    /// \brief Returns the grid cell containing the given position.
+    ///
+    /// \param [in] pos     Position in scene coordinates.
+    ///
+    /// \return             Grid cell coordinates.
+    ///
+    QPoint getCellOf(const QPointF& pos) const;
+
+    ///
+    /// \brief Returns the range of grid cells covered by the given rectangle.
+    ///
+    /// \param [in] rect    Rectangle in scene coordinates.
+    ///
+    /// \return             Range of grid cells, inclusive.
+    ///
+    QRect getCellsOf(const QRectF& rect) const;
+
+    ///
+    /// \brief Adds or removes a Node to or from all cells in the given range.
+    ///
+    /// \param [in] node    Node to add or remove.
+    /// \param [in] cells   Range of grid cells.
+    /// \param [in] insert  <i>true</i> to add the Node -- <i>false</i> to remove it.
+    ///
+    void registerNode(Node* node, const QRect& cells, bool insert);
+
+    ///
+    /// \brief Counts a Perimeter radius in or out of the radius register.
+    ///
+    /// \param [in] radius  Radius of a Node.
+    /// \param [in] insert  <i>true</i> to count the radius in -- <i>false</i> to count it out.
+    ///
+    void registerRadius(qreal radius, bool insert);
+
+private: // members
+
+    ///
+    /// \brief Index entry of a single Node.
+    ///
+    struct Entry {
+        QPointF center;     ///< Center of the Node in scene coordinates.
+        qreal radius;       ///< Radius of the Node's Perimeter.
+        QRect cells;        ///< Range of grid cells that the Node is registered in.
+    };
+
+    ///
+    /// \brief Side length of a grid cell of this index.
+    ///
+    qreal m_cellSize;
+
+    ///
+    /// \brief All Node%s in the index.
+    ///
+    QHash<Node*, Entry> m_entries;
+
+    ///
+    /// \brief All occupied grid cells and the Node%s overlapping them.
+    ///
+    /// Cells are identified by their packed coordinates, see gridCellKey().
+    ///
+    QHash<qint64, QSet<Node*>> m_cells;
+
+    ///
+    /// \brief Number of Node%s in the index for each Perimeter radius.
+    ///
+    /// The last key is the largest radius, by which rectangle queries have to be extended.
+    ///
+    QMap<qreal, int> m_radii;
+
+private: // static members
+
+    ///
+    /// \brief Side length of a grid cell used for new NodeIndex instances.
+    ///
+    static qreal s_cellSize;
+
+};
+
+} // namespace zodiac
+
+#endif // ZODIAC_NODEINDEX_H
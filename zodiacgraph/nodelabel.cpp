@@ -6,6 +6,8 @@
 #include <QPainter>
 
 #include "node.h"
+#include "scene.h"
+#include "utils.h"
 
 namespace zodiac {
 
@@ -21,6 +23,7 @@ QPen NodeLabel::s_linePen = QPen(QBrush(s_lineColor), s_outlineWidth);
 
 NodeLabel::NodeLabel(Node* parent)
     : QGraphicsObject(parent)
+    , m_node(parent)
 {
     // core only expands if you hover above it, not above the label
     setAcceptHoverEvents(false);
@@ -35,11 +38,7 @@ NodeLabel::NodeLabel(Node* parent)
 void NodeLabel::setText(const QString& text)
 {
     // update the text
-    m_text = QStaticText(text);
-    m_text.setTextFormat(Qt::PlainText);
-    QTextOption textOption = QTextOption(Qt::AlignHCenter | Qt::AlignBaseline);
-    textOption.setUseDesignMetrics(false);
-    m_text.setTextOption(textOption);
+    m_text.setText(text);
     updateStyle();
 }
 
@@ -47,8 +46,12 @@ void NodeLabel::updateStyle()
 {
     prepareGeometryChange();
 
+    // get the shared layout of the text
+    QTextOption textOption = QTextOption(Qt::AlignHCenter | Qt::AlignBaseline);
+    textOption.setUseDesignMetrics(false);
+    m_text = m_node->getScene()->getTextLayoutCache().getText(m_text.text(), s_font, textOption);
+
     // update the text position
-    m_text.prepare(QTransform(), s_font);
     QSizeF textSize = m_text.size();
     m_textPos = QPointF(textSize.width()/-2., textSize.height()/-2.);
 
@@ -71,6 +74,12 @@ QRectF NodeLabel::boundingRect() const
 
 void NodeLabel::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* /* widget */)
 {
+    // labels are skipped while a View renders in draft quality
+    Scene* zodiacScene = static_cast<Scene*>(scene());
+    if(!zodiacScene->areLabelsVisible()){
+        return;
+    }
+    zodiacScene->getCachePolicy().recordRender(CachedItem::NODE_LABEL);
     painter->setClipRect(option->exposedRect);
 
     // draw the background
@@ -103,13 +112,15 @@ void NodeLabel::mousePressEvent(QGraphicsSceneMouseEvent* event)
         if(event->modifiers() & Qt::ControlModifier){
             parentItem()->setSelected(!parentItem()->isSelected()); // multi-selection
         } else {
-            for(QGraphicsItem* item : scene()->selectedItems()){    // single selection
-                item->setSelected(false);
-            }
-            parentItem()->setSelected(true);
+            m_node->getScene()->setNodeSelection({m_node});        // single selection
         }
         event->accept();
     }
 }
 
+int NodeLabel::type() const
+{
+    return itemType::NODE_LABEL_TYPE;
+}
+
 } // namespace zodiac
@@ -82,6 +82,13 @@ public: // methods
     ///
     void updateStyle();
 
+    ///
+    /// \brief Custom QGraphicsItem type of the NodeLabel, used by the CachePolicy of the Scene.
+    ///
+    /// \return The type of this item.
+    ///
+    int type() const;
+
 public: // static methods
 
     ///
@@ -261,6 +268,11 @@ protected: // methods
 
 private: // members
 
+    ///
+    /// \brief Node owning this NodeLabel.
+    ///
+    Node* m_node;
+
     ///
     /// \brief Text of this label.
     ///
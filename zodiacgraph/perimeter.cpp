@@ -8,6 +8,7 @@
 #include "utils.h"
 #include "node.h"
 #include "view.h"
+#include "scene.h"
 
 namespace zodiac {
 
@@ -40,6 +41,7 @@ QRectF Perimeter::boundingRect() const
 
 void Perimeter::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* /* widget */)
 {
+    static_cast<Scene*>(scene())->getCachePolicy().recordRender(CachedItem::PERIMETER);
     painter->setClipRect(option->exposedRect);
 
     // draw perimeter
@@ -130,4 +132,9 @@ void Perimeter::mouseDoubleClickEvent(QGraphicsSceneMouseEvent* event)
     return QGraphicsObject::mouseDoubleClickEvent(event);
 }
 
+int Perimeter::type() const
+{
+    return itemType::PERIMETER_TYPE;
+}
+
 } // namespace zodiac
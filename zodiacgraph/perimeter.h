@@ -79,6 +79,13 @@ public: // methods
     ///
     inline void updateStyle() {update();}
 
+    ///
+    /// \brief Custom QGraphicsItem type of the Perimeter, used by the CachePolicy of the Scene.
+    ///
+    /// \return The type of this item.
+    ///
+    int type() const;
+
 public: // static methods
 
     ///
@@ -1,20 +1,19 @@
 #include "plug.h"
 
 #include <QGraphicsSceneMouseEvent>
-#include <QtMath>                       // for M_PI, qRadiansToDegrees
+#include <QtMath>                       // for qDegreesToRadians
 #include <QPainter>
 #include <QStyleOptionGraphicsItem>
 
 #include "drawedge.h"
 #include "node.h"
 #include "scene.h"
+#include "signalhub.h"
 #include "utils.h"
 #include "perimeter.h"
 #include "plugedge.h"
 #include "pluglabel.h"
 
-static QGraphicsItem* getRootItemOf(QGraphicsItem* item);
-
 namespace zodiac {
 
 qreal Plug::s_width = 12.;
@@ -34,6 +33,9 @@ Plug::Plug(Node* parent, const QString& name, PlugDirection direction)
     , m_node(parent)
     , m_arclength(0.1)
     , m_normal(QVector2D(1.,0.))
+    , m_sectorCenter(QPointF())
+    , m_sectorRadius(0.)
+    , m_sectorAngle(0.)
     , m_shape(QPainterPath())
     , m_isHighlighted(false)
     , m_edges(QSet<PlugEdge*>())
@@ -52,6 +54,8 @@ Plug::Plug(Node* parent, const QString& name, PlugDirection direction)
 
     // create a label for this plug
     m_label = new PlugLabel(this);
+    m_node->getScene()->getCachePolicy().apply(this);
+    m_node->getScene()->getCachePolicy().apply(m_label);
 
     // initialize the members of this plug with default values
     setHighlight(false);
@@ -120,13 +124,6 @@ void Plug::defineShape(QVector2D normal, qreal arclength)
     updateShape();
 }
 
-void Plug::updateEdges() const
-{
-    foreach (PlugEdge* edge, m_edges){
-        edge->plugHasChanged();
-    }
-}
-
 void Plug::updateExpansion(qreal expansion)
 {
     // use visibility toggle to adjust edge stretch if necessary
@@ -139,9 +136,6 @@ void Plug::updateExpansion(qreal expansion)
 
     // update label tranparency
     m_label->setOpacity(expansion);
-
-    // update any connected edges
-    updateEdges();
 }
 
 void Plug::setHighlight(bool highlight)
@@ -196,19 +190,8 @@ void Plug::advanceDrawEdge(const QPointF& scenePos)
     DrawEdge* drawEdge = m_node->getScene()->getDrawEdge();
     drawEdge->setVisible(true);
 
-    // find the topmost node under the mouse cursor
-    Node* targetNode = nullptr;
-    QGraphicsItem* plugNode = parentItem(); // the parent item of this plug is always its node
-    for(QGraphicsItem* currentItem : scene()->items(scenePos)){
-        QGraphicsItem* rootItem = getRootItemOf(currentItem);
-        if((!rootItem) || (rootItem == plugNode)){
-            continue;
-        }
-        targetNode = qobject_cast<Node*>(rootItem->toGraphicsObject());
-        if(targetNode){
-            break;
-        }
-    }
+    // find the node under the mouse cursor through the scene's node index
+    Node* targetNode = m_node->getScene()->getNodeIndex().getNodeAt(scenePos, m_node);
 
     // if we found a node and if it is not already the dragTargetNode, collapse the old node and expand the current
     if(targetNode){
@@ -305,6 +288,11 @@ void Plug::updateStyle()
     update();
 }
 
+void Plug::updateLabel()
+{
+    m_label->update();
+}
+
 qreal Plug::getArrangementPriority()
 {
     qreal factor=0.;
@@ -322,6 +310,7 @@ QRectF Plug::boundingRect() const
 
 void Plug::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* /* widget */)
 {
+    static_cast<Scene*>(scene())->getCachePolicy().recordRender(CachedItem::PLUG);
     painter->setClipRect(option->exposedRect);
 
     // define the pen to draw this plug
@@ -337,6 +326,14 @@ void Plug::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWid
         }
     }
 
+    // blit the plug from a shared sprite, if possible
+    SpriteAtlas& spriteAtlas = m_node->getScene()->getSpriteAtlas();
+    if((spriteAtlas.isEnabled())
+            && (spriteAtlas.drawSector(painter, m_sectorCenter, m_sectorRadius-(s_width/2.),
+                                       m_sectorRadius+(s_width/2.), m_sectorAngle, m_arclength, brush.color()))){
+        return;
+    }
+
     // draw the plug
     painter->setPen(Qt::NoPen);
     painter->setBrush(brush);
@@ -393,6 +390,7 @@ void Plug::setName(const QString& name)
     updateEdgeLabels();
     updateStyle();
     emit plugRenamed(m_name);
+    emit m_node->getScene()->getSignalHub()->plugRenamed(PlugHandle(this), m_name);
 }
 
 void Plug::updateShape()
@@ -404,22 +402,17 @@ void Plug::updateShape()
     // as it turns out, rotating stuff (especially with labels attached that also rotate)
     // is a MAYOR performance killer
     qreal perimeterRadius = m_node->getPerimeterRadius()-(m_direction==PlugDirection::IN?s_width:0.);
-    qreal arclength = qRadiansToDegrees(m_arclength);
-    qreal arcpos = qRadiansToDegrees(atan2(-m_normal.y(), m_normal.x()));
+    m_sectorCenter = -m_normal.toPointF()*perimeterRadius;
+    m_sectorRadius = perimeterRadius;
+    m_sectorAngle = atan2(-m_normal.y(), m_normal.x());
 
-    QPointF rectOffset = QPointF(-m_normal.x()*perimeterRadius, -m_normal.y()*perimeterRadius);
-    QRectF outsideRect =quadrat(perimeterRadius+(s_width/2.));
-    outsideRect.translate(rectOffset);
-    QRectF insideRect =quadrat(perimeterRadius-(s_width/2.));
-    insideRect.translate(rectOffset);
+    // the annulus sector is built directly as a polygon, with enough segments per arc to appear round
+    QPolygonF polygon = annulusSector(m_sectorCenter, perimeterRadius-(s_width/2.), perimeterRadius+(s_width/2.),
+                                      m_sectorAngle, m_arclength);
 
     QPainterPath path;
-    path.arcMoveTo(outsideRect,arcpos+(arclength/2.));
-    path.arcTo(outsideRect,arcpos+(arclength/2.),-arclength);
-    path.arcTo(insideRect,arcpos-(arclength/2.), 0.);
-    path.arcTo(insideRect,arcpos-(arclength/2.),arclength);
+    path.addPolygon(polygon);
     path.closeSubpath();
-    path = path.simplified();
     m_shape.swap(path);
 
     m_label->updateShape();
@@ -435,30 +428,9 @@ bool Plug::mayReceiveInput()
     }
 }
 
-} // namespace zodiac
-
-///////////////////////////////////////////////////////////////////////////////////////////////////
-//
-// HELPER
-//
-
-///
-/// \brief Finds the root item in the ancestry of this item
-///
-/// Ignores items that do not accept hover events.
-///
-/// \param [in] item    Item for which to search to root item.
-///
-/// \return             The pointer to the root item of the one given or the null pointer.
-///
-static QGraphicsItem* getRootItemOf(QGraphicsItem* item)
+int Plug::type() const
 {
-    for(QGraphicsItem* childItem = item; childItem!=nullptr; childItem=childItem->parentItem()){
-        if(childItem->acceptHoverEvents()){
-            item = childItem;
-        } else {    // do not traverse past items that do not accept mouse hover events (like labels)
-            return nullptr;
-        }
-    }
-    return item;
+    return itemType::PLUG_TYPE;
 }
+
+} // namespace zodiac
@@ -120,14 +120,11 @@ public: // methods
     ///
     void defineShape(QVector2D normal, qreal arclength);
 
-    ///
-    /// \brief Updates all connected PlugEdge%s, if the Plug has changed.
-    ///
-    void updateEdges() const;
-
     ///
     /// \brief Repositions the Plug based on the expansion / collapse animations of its Node.
     ///
+    /// Does not update the connected PlugEdge%s, so the Node can update the edges of all its Plug%s in a single batch.
+    ///
     /// \param [in] expansion   New expansion factor [0 -> 1].
     ///
     void updateExpansion(qreal expansion);
@@ -185,6 +182,13 @@ public: // methods
     ///
     inline int getEdgeCount() const {return m_edges.size();}
 
+    ///
+    /// \brief All PlugEdge%s connected to this Plug.
+    ///
+    /// \return This Plug's edges.
+    ///
+    inline const QSet<PlugEdge*>& getEdges() const {return m_edges;}
+
     ///
     /// \brief Only Plug%s with no connections can be removed.
     ///
@@ -241,6 +245,11 @@ public: // methods
     ///
     void updateStyle();
 
+    ///
+    /// \brief Repaints the PlugLabel of this Plug, discarding its item cache.
+    ///
+    void updateLabel();
+
     ///
     /// \brief Calculates and returns the priority factor for the arrangement of this Plug.
     ///
@@ -251,6 +260,13 @@ public: // methods
     ///
     qreal getArrangementPriority();
 
+    ///
+    /// \brief Custom QGraphicsItem type of the Plug, used by the CachePolicy of the Scene.
+    ///
+    /// \return The type of this item.
+    ///
+    int type() const;
+
 signals:
 
     ///
@@ -498,6 +514,21 @@ private: // members
     ///
     QVector2D m_normal;
 
+    ///
+    /// \brief Center of the annulus that the sector of this Plug is a part of, in Plug coordinates.
+    ///
+    QPointF m_sectorCenter;
+
+    ///
+    /// \brief Radius at the middle of the sector of this Plug.
+    ///
+    qreal m_sectorRadius;
+
+    ///
+    /// \brief Angle in radians at the middle of the sector of this Plug.
+    ///
+    qreal m_sectorAngle;
+
     ///
     /// \brief Shape used to draw this Plug.
     ///
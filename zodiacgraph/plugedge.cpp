@@ -23,11 +23,9 @@ PlugEdge::PlugEdge(Scene* scene, Plug* startPlug, Plug* endPlug, EdgeGroup* edge
     m_endPlug->addEdge(this);
 
     // register with your edge group
+    // the label text of this edge is only produced, once the edge is hovered
     m_group->addEdge(this);
 
-    // create the label for this edge
-    updateLabelText();
-
     // initialize
     plugHasChanged();
 }
@@ -35,19 +33,11 @@ PlugEdge::PlugEdge(Scene* scene, Plug* startPlug, Plug* endPlug, EdgeGroup* edge
 void PlugEdge::plugHasChanged()
 {
     // update the count of bent edges in the group, if necessary
-    bool isBent = m_startPlug->isVisible() || m_endPlug->isVisible();
-    if(m_isBent!=isBent){
-        m_isBent = isBent;
-        if(m_isBent){
-            m_group->increaseBentCount();
-        }else{
-            m_group->decreaseBentCount();
-        }
-    }
+    updateBentState();
 
-    // return early, if the shape of the edge has not changed
-    QPointF startPoint = m_startPlug->scenePos();
-    QPointF endPoint = m_endPlug->scenePos();
+    // return early, if the shape of the edge has not changed (the edge might be moved as part of a DragLayer)
+    QPointF startPoint = mapFromScene(m_startPlug->scenePos());
+    QPointF endPoint = mapFromScene(m_endPlug->scenePos());
     if((startPoint==m_startPoint)&&(endPoint==m_endPoint)){
         return;
     }
@@ -62,6 +52,25 @@ void PlugEdge::plugHasChanged()
     updateShape();
 }
 
+void PlugEdge::updateBentState()
+{
+    bool isBent = m_startPlug->isVisible() || m_endPlug->isVisible();
+    if(m_isBent!=isBent){
+        m_isBent = isBent;
+        if(m_isBent){
+            m_group->increaseBentCount();
+        }else{
+            m_group->decreaseBentCount();
+        }
+    }
+}
+
+void PlugEdge::updateLabelText()
+{
+    invalidateLabelText();
+    m_group->renameEdge(this);
+}
+
 QString PlugEdge::getLabelText()
 {
     return LabelTextFactory(this).produceLabel();
@@ -50,6 +50,11 @@ class PlugEdge : public BezierEdge
 
     Q_OBJECT
 
+    ///
+    /// \brief The EdgeGeometryBuffer calculates the control points of many PlugEdge%s at once and writes them back.
+    ///
+    friend class EdgeGeometryBuffer;
+
 public: // methods
 
     ///
@@ -65,6 +70,8 @@ public: // methods
     ///
     /// \brief Is called by a plug to notify the edge of a change in its state.
     ///
+    /// To update many PlugEdge%s at once, use the Scene's EdgeGeometryBuffer instead.
+    ///
     void plugHasChanged();
 
     ///
@@ -96,14 +103,16 @@ public: // methods
     ///
     /// \brief Updates the EdgeLabel to reflect changes in the attached Plug%s and / or Node%s.
     ///
-    inline void updateLabelText() {setLabelText(getLabelText());}
+    /// The new text is only produced, when the label is shown next.
+    ///
+    void updateLabelText();
 
     ///
     /// \brief Generates the EdgeLabel's text by using information from the start and end Node of this PlugEdge.
     ///
     /// \return Text used for the EdgeLabel.
     ///
-    QString getLabelText();
+    virtual QString getLabelText();
 
     ///
     /// \brief Sets the text of this edge's EdgeLabel.
@@ -132,6 +141,15 @@ protected: // methods
     ///
     void mouseDoubleClickEvent(QGraphicsSceneMouseEvent *event);
 
+private: // methods
+
+    ///
+    /// \brief Updates the count of bent edges in the EdgeGroup, if this PlugEdge has started or stopped being bent.
+    ///
+    /// A PlugEdge is bent, as long as at least one of its Plug%s is visible.
+    ///
+    void updateBentState();
+
 private: // members
 
     ///
@@ -10,30 +10,17 @@
 namespace zodiac {
 
 PlugHandle::PlugHandle(Plug* plug)
-    : QObject(nullptr)
-    , m_plug(plug)
-    , m_isValid(plug!=nullptr)
+    : m_plug(plug)
+    , m_reference(plug)
 {
-    connectSignals();
-}
-
-PlugHandle& PlugHandle::operator = (const PlugHandle& other)
-{
-    if(m_plug){
-        m_plug->disconnect(this);
-    }
-    m_plug = other.data();
-    m_isValid = m_plug != nullptr;
-    connectSignals();
-    return *this;
 }
 
 bool PlugHandle::isRemovable() const
 {
 #ifdef QT_DEBUG
-    Q_ASSERT(m_isValid);
+    Q_ASSERT(isValid());
 #else
-    if(!m_isValid){
+    if(!isValid()){
         return false;
     }
 #endif
@@ -43,14 +30,14 @@ bool PlugHandle::isRemovable() const
 bool PlugHandle::remove()
 {
 #ifdef QT_DEBUG
-    Q_ASSERT(m_isValid);
+    Q_ASSERT(isValid());
 #else
-    if(!m_isValid){
+    if(!isValid()){
         return false;
     }
 #endif
     if(m_plug->getNode()->removePlug(m_plug)){
-        m_isValid = false;
+        m_reference.clear();
         return true;
     } else {
         return false;
@@ -60,9 +47,9 @@ bool PlugHandle::remove()
 QString PlugHandle::getName() const
 {
 #ifdef QT_DEBUG
-    Q_ASSERT(m_isValid);
+    Q_ASSERT(isValid());
 #else
-    if(!m_isValid){
+    if(!isValid()){
         return "";
     }
 #endif
@@ -72,9 +59,9 @@ QString PlugHandle::getName() const
 QString PlugHandle::rename(const QString& name)
 {
 #ifdef QT_DEBUG
-    Q_ASSERT(m_isValid);
+    Q_ASSERT(isValid());
 #else
-    if(!m_isValid){
+    if(!isValid()){
         return "";
     }
 #endif
@@ -84,9 +71,9 @@ QString PlugHandle::rename(const QString& name)
 bool PlugHandle::toggleDirection()
 {
 #ifdef QT_DEBUG
-    Q_ASSERT(m_isValid);
+    Q_ASSERT(isValid());
 #else
-    if(!m_isValid){
+    if(!isValid()){
         return false;
     }
 #endif
@@ -96,9 +83,9 @@ bool PlugHandle::toggleDirection()
 bool PlugHandle::isIncoming() const
 {
 #ifdef QT_DEBUG
-    Q_ASSERT(m_isValid);
+    Q_ASSERT(isValid());
 #else
-    if(!m_isValid){
+    if(!isValid()){
         return false;
     }
 #endif
@@ -108,9 +95,9 @@ bool PlugHandle::isIncoming() const
 bool PlugHandle::isOutgoing() const
 {
 #ifdef QT_DEBUG
-    Q_ASSERT(m_isValid);
+    Q_ASSERT(isValid());
 #else
-    if(!m_isValid){
+    if(!isValid()){
         return false;
     }
 #endif
@@ -120,9 +107,9 @@ bool PlugHandle::isOutgoing() const
 int PlugHandle::connectionCount() const
 {
 #ifdef QT_DEBUG
-    Q_ASSERT(m_isValid);
+    Q_ASSERT(isValid());
 #else
-    if(!m_isValid){
+    if(!isValid()){
         return 0;
     }
 #endif
@@ -132,9 +119,9 @@ int PlugHandle::connectionCount() const
 QList<PlugHandle> PlugHandle::getConnectedPlugs() const
 {
 #ifdef QT_DEBUG
-    Q_ASSERT(m_isValid);
+    Q_ASSERT(isValid());
 #else
-    if(!m_isValid){
+    if(!isValid()){
         return QList<PlugHandle>();
     }
 #endif
@@ -148,9 +135,9 @@ QList<PlugHandle> PlugHandle::getConnectedPlugs() const
 bool PlugHandle::connectPlug(PlugHandle other)
 {
 #ifdef QT_DEBUG
-    Q_ASSERT(m_isValid);
+    Q_ASSERT(isValid());
 #else
-    if(!m_isValid){
+    if(!isValid()){
         return false;
     }
 #endif
@@ -165,9 +152,9 @@ bool PlugHandle::connectPlug(PlugHandle other)
 bool PlugHandle::disconnectPlug(PlugHandle other)
 {
 #ifdef QT_DEBUG
-    Q_ASSERT(m_isValid && other.isValid());
+    Q_ASSERT(isValid() && other.isValid());
 #else
-    if(!m_isValid || !other.isValid()){
+    if(!isValid() || !other.isValid()){
         return false;
     }
 #endif
@@ -188,9 +175,9 @@ bool PlugHandle::disconnectPlug(PlugHandle other)
 void PlugHandle::disconnectAll()
 {
 #ifdef QT_DEBUG
-    Q_ASSERT(m_isValid);
+    Q_ASSERT(isValid());
 #else
-    if(!m_isValid){
+    if(!isValid()){
         return;
     }
 #endif
@@ -210,9 +197,9 @@ void PlugHandle::disconnectAll()
 NodeHandle PlugHandle::getNode() const
 {
 #ifdef QT_DEBUG
-    Q_ASSERT(m_isValid);
+    Q_ASSERT(isValid());
 #else
-    if(!m_isValid){
+    if(!isValid()){
         return NodeHandle();
     }
 #endif
@@ -222,32 +209,14 @@ NodeHandle PlugHandle::getNode() const
 SceneHandle PlugHandle::getScene() const
 {
 #ifdef QT_DEBUG
-    Q_ASSERT(m_isValid);
+    Q_ASSERT(isValid());
 #else
-    if(!m_isValid){
+    if(!isValid()){
         return SceneHandle();
     }
 #endif
     return SceneHandle(m_plug->getNode()->getScene());
 }
 
-void PlugHandle::connectSignals()
-{
-    if(!m_isValid){
-        return;
-    }
-    connect(m_plug, SIGNAL(destroyed()), this, SLOT(plugWasDestroyed()));
-    connect(m_plug, SIGNAL(plugRenamed(QString)), this, SIGNAL(plugRenamed(QString)));
-}
-
-void PlugHandle::plugWasDestroyed()
-{
-#ifdef QT_DEBUG
-    Q_ASSERT(m_isValid);
-#endif
-    m_isValid = false;
-    this->disconnect();
-}
-
 } // namespace zodiac
 
@@ -31,8 +31,9 @@
 /// \brief Contains the definition of the zodiac::PlugHandle class.
 ///
 
-#include <QObject>
 #include <QHash>
+#include <QMetaType>
+#include <QPointer>
 
 namespace zodiac {
 
@@ -47,11 +48,12 @@ class SceneHandle;
 ///
 /// See \ref zodiac::SceneHandle "SceneHandle" for more details on handles.
 ///
-class PlugHandle : public QObject
+/// PlugHandle%s are cheap values, which can be copied and stored in large numbers.
+/// They do not emit signals by themselves, all notifications about Plug%s are emitted by the SignalHub of the Scene.
+///
+class PlugHandle
 {
 
-    Q_OBJECT
-
 public: // methods
 
     ///
@@ -66,8 +68,7 @@ public: // methods
     ///
     /// \param [in] other   Other PlugHandle to copy.
     ///
-    PlugHandle(const PlugHandle& other)
-        : PlugHandle(other.data()) {}
+    PlugHandle(const PlugHandle& other) = default;
 
     ///
     /// \brief Assignment operator.
@@ -76,7 +77,7 @@ public: // methods
     ///
     /// \return             This.
     ///
-    PlugHandle& operator = (const PlugHandle& other);
+    PlugHandle& operator = (const PlugHandle& other) = default;
 
     ///
     /// \brief Equality operator.
@@ -99,7 +100,7 @@ public: // methods
     ///
     /// \return <i>true</i> if the PlugHandle is still managing an existing Plug -- <i>false</i> otherwise.
     ///
-    inline bool isValid() const {return m_isValid;}
+    inline bool isValid() const {return !m_reference.isNull();}
 
     ///
     /// \brief Only Plug%s with no connections can be removed.
@@ -205,8 +206,6 @@ public: // methods
     ///
     SceneHandle getScene() const;
 
-public slots:
-
     ///
     /// \brief Renames this Plug to a new name.
     ///
@@ -218,40 +217,21 @@ public slots:
     ///
     QString rename(const QString& name);
 
-signals:
-
-    ///
-    /// \brief Is emitted, when the plug was renamed.
-    ///
-    /// \param [out] name   New name of the plug.
-    ///
-    void plugRenamed(const QString& name);
-
-private: // methods
-
-    ///
-    /// \brief Connects the handle to its managed object.
-    ///
-    void connectSignals();
-
-private slots:
-
-    ///
-    /// \brief Called, when the mangaged Plug was destroyed.
-    ///
-    void plugWasDestroyed();
-
 private: // member
 
     ///
     /// \brief Managed plug.
     ///
+    /// Identifies the handle and is never changed or set to <i>nullptr</i>, even after the Plug was deleted.
+    ///
     Plug* m_plug;
 
     ///
-    /// \brief Validity flag.
+    /// \brief Weak reference to the managed plug.
     ///
-    bool m_isValid;
+    /// Is automatically reset, when the Plug is destroyed and cleared, when it is removed through this handle.
+    ///
+    QPointer<Plug> m_reference;
 
 };
 
@@ -272,4 +252,6 @@ inline uint qHash(const zodiac::PlugHandle& key)
     return qHash(size_t(key.data()));
 }
 
+Q_DECLARE_METATYPE(zodiac::PlugHandle)
+
 #endif // ZODIAC_PLUGHANDLE_H
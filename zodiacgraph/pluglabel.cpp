@@ -4,7 +4,10 @@
 #include <QPainter>
 #include <QStyleOptionGraphicsItem>
 
+#include "node.h"
 #include "plug.h"
+#include "scene.h"
+#include "utils.h"
 
 namespace zodiac {
 
@@ -32,28 +35,30 @@ void PlugLabel::updateShape()
 {
     prepareGeometryChange();
 
-    // update the text
-    m_text = QStaticText(m_plug->getName());
-    m_text.setTextFormat(Qt::PlainText);
-    m_text.prepare(QTransform(), s_font); // prepare once to get the dimensions of the text
-
-    // update the label transformation
+    // the label is drawn with the rotation of its bucket, so it can share the layout of all labels in the bucket
     QVector2D normal = m_plug->getNormal();
     qreal angle = atan2(-normal.y(), normal.x());
+    if(normal.x()<=0){  // label is on the left
+        angle+=M_PI;
+    }
+    int rotationBucket = TextLayoutCache::getRotationBucket(-angle);
+
+    // get the shared layout of the text
+    m_text = m_plug->getNode()->getScene()->getTextLayoutCache().getText(m_plug->getName(), s_font, QTextOption(),
+                                                                         rotationBucket);
+
+    // update the label transformation
     QSizeF textSize = m_text.size();
     qreal xOffset;
     if(normal.x()>0){   // label is on the right
         xOffset = s_labelDistance;
     } else {            // label is on the left
         xOffset = -textSize.width()-s_labelDistance;
-        angle+=M_PI;
     }
     m_transform.reset();
-    m_transform.rotateRadians(-angle);
+    m_transform.rotate(rotationBucket);
     m_transform.translate(xOffset, textSize.height()/-2.);
 
-    m_text.prepare(m_transform, s_font);    // prepare a second time with the correct transform matrix
-
     // update the bounding rect
     m_boundingRect = m_transform.mapRect(QRectF(0, 0, textSize.width(), textSize.height()));
 }
@@ -71,6 +76,12 @@ QRectF PlugLabel::boundingRect() const
 
 void PlugLabel::paint(QPainter* painter, const QStyleOptionGraphicsItem* option, QWidget* /*widget*/)
 {
+    // labels are skipped while a View renders in draft quality
+    Scene* zodiacScene = static_cast<Scene*>(scene());
+    if(!zodiacScene->areLabelsVisible()){
+        return;
+    }
+    zodiacScene->getCachePolicy().recordRender(CachedItem::PLUG_LABEL);
     painter->setClipRect(option->exposedRect);
     painter->setTransform(m_transform * painter->transform());
     painter->setFont(s_font);
@@ -85,4 +96,9 @@ QPainterPath PlugLabel::shape() const
     return path;
 }
 
+int PlugLabel::type() const
+{
+    return itemType::PLUG_LABEL_TYPE;
+}
+
 } // namespace zodiac
@@ -77,6 +77,13 @@ public: // methods
     ///
     void updateStyle();
 
+    ///
+    /// \brief Custom QGraphicsItem type of the PlugLabel, used by the CachePolicy of the Scene.
+    ///
+    /// \return The type of this item.
+    ///
+    int type() const;
+
 public: // static methods
 
     ///
@@ -2,48 +2,87 @@
 
 #include <time.h>
 
+#include "baseedge.h"
+#include "draglayer.h"
 #include "drawedge.h"
 #include "edgegroup.h"
 #include "edgegrouppair.h"
 #include "node.h"
+#include "perimeter.h"
 #include "plug.h"
 #include "plugedge.h"
+#include "straightdoubleedge.h"
+#include "view.h"
 
 namespace zodiac {
 
 Scene::Scene(QObject *parent)
     : QGraphicsScene(parent)
     , m_drawEdge(nullptr)
+    , m_dragLayer(nullptr)
     , m_nodes(QSet<Node*>())
+    , m_nodesById(QHash<QUuid, Node*>())
+    , m_selectedNodes(QSet<Node*>())
+    , m_newlySelectedNodes(QSet<NodeHandle>())
+    , m_newlyDeselectedNodes(QSet<NodeHandle>())
     , m_edges(QHash<QPair<Plug*, Plug*>, PlugEdge*>())
-    , m_edgeGroups(QHash<uint, EdgeGroup*>())
+    , m_edgeGroups(QHash<QPair<Node*, Node*>, EdgeGroup*>())
     , m_edgeGroupPairs(QSet<EdgeGroupPair*>())
+    , m_edgeGeometryBuffer(EdgeGeometryBuffer())
+    , m_nodeIndex(NodeIndex())
+    , m_edgeIndex(EdgeIndex())
+    , m_edgeIndexMethod(EdgeIndexMethod::SCENE_INDEX)
+    , m_areLabelsVisible(true)
+    , m_cachePolicy(CachePolicy(this))
+    , m_spriteAtlas(SpriteAtlas())
+    , m_textLayoutCache(TextLayoutCache())
+    , m_signalHub(new SignalHub(this))
 {
+    // items drawn from the sprite atlas are not cached by themselves
+    m_cachePolicy.refresh();
+
     // add the draw edge to the scene
     m_drawEdge = new DrawEdge(this);
     m_drawEdge->setVisible(false);
+
+    // add the drag layer to the scene
+    m_dragLayer = new DragLayer(this);
+
+    // announce the changed Node%s along with each change of the selection
+    connect(this, SIGNAL(selectionChanged()), this, SLOT(emitSelectionChange()));
 }
 
 Scene::~Scene()
 {
+    // the base class deletes the remaining items after the members of this Scene are gone, selected Nodes among them
+    disconnect(this, SIGNAL(selectionChanged()), this, SLOT(emitSelectionChange()));
+
+    // edge labels are top-level items as well, they must be gone before the base class deletes all items at once
+    for(BaseEdge* edge : getAllEdges()){
+        edge->discardLabel();
+    }
+
+    // edges are deleted after the edge index, so they must not try to unregister from it
+    m_edgeIndex.clear();
+
     // most members are implicitly removed through Qt's parent-child mechanism
     m_drawEdge = nullptr;
+    m_dragLayer = nullptr;
     m_nodes.clear();
     m_edges.clear();
 
     // EdgeGroups belong to EdgeGroupPairs, which we need to delete manually
-    m_edgeGroups.clear();
-    for(EdgeGroupPair* edgeGroupPair : m_edgeGroupPairs){
-        delete edgeGroupPair;
-    }
-    m_edgeGroupPairs.clear();
+    releaseEdgeGroupPairs();
 }
 
 Node* Scene::createNode(const QString &name, const QUuid& uuid)
 {
     Node* newNode = new Node(this, name, uuid);
     m_nodes.insert(newNode);
+    m_nodesById.insert(newNode->getUniqueId(), newNode);
     addItem(newNode);
+    m_nodeIndex.addNode(newNode);
+    emit m_signalHub->nodeCreated(NodeHandle(newNode));
     return newNode;
 }
 
@@ -62,14 +101,194 @@ bool Scene::removeNode(Node* node)
         return false;
     }
 
+    // finish the current drag, so the drag layer does not keep a reference to the node
+    m_dragLayer->commit();
+    forgetNodes(QList<Node*>() << node);
+
     // delete all references to the node and finally the node itself
+    if(m_selectedNodes.contains(node)){
+        nodeSelectionHasChanged(node, false);
+    }
     m_nodes.remove(node);
+    m_nodesById.remove(node->getUniqueId());
+    m_nodeIndex.removeNode(node);
     removeItem(node);
     node->deleteLater();
 
+    // emit signals
+    emit m_signalHub->nodesRemoved(QList<NodeHandle>() << NodeHandle(node));
+
     return true;
 }
 
+int Scene::removeNodes(const QList<Node*>& nodes)
+{
+    // collect the Nodes to remove
+    QSet<Node*> removedNodes;
+    removedNodes.reserve(nodes.size());
+    for(Node* node : nodes){
+#ifdef QT_DEBUG
+        Q_ASSERT(m_nodes.contains(node));
+#else
+        if(!m_nodes.contains(node)){
+            continue;
+        }
+#endif
+        removedNodes.insert(node);
+    }
+    if(removedNodes.isEmpty()){
+        return 0;
+    }
+
+    // finish the current drag, so the drag layer does not keep a reference to any of the removed items
+    QList<Node*> removedNodeList = removedNodes.toList();
+    m_dragLayer->commit();
+    forgetNodes(removedNodeList);
+
+    // every edge between a removed Node and one of its neighbors is removed, so all of their pairs are removed entirely
+    QSet<EdgeGroupPair*> removedPairs;
+    int removedEdgeCount = 0;
+    for(Node* node : removedNodes){
+        for(EdgeGroupPair* pair : node->getEdgeGroupPairs()){
+            if(!removedPairs.contains(pair)){
+                removedPairs.insert(pair);
+                removedEdgeCount += pair->getFirstGroup()->getEdgeCount() + pair->getSecondGroup()->getEdgeCount();
+            }
+        }
+    }
+
+    // removing many items is faster without an index that has to follow every single removal
+    ItemIndexMethod previousIndexMethod = itemIndexMethod();
+    if((previousIndexMethod!=QGraphicsScene::NoIndex)
+            && (removedNodes.size()+removedEdgeCount >= DragLayer::getUnindexedThreshold())){
+        setItemIndexMethod(QGraphicsScene::NoIndex);
+    }
+
+    // collect all selection changes and only notify once at the end
+    bool wasBlocked = blockSignals(true);
+    bool selectionHasChanged = false;
+
+    // remove the edges without updating their groups, which are deleted right after
+    QList<QPair<Plug*, Plug*>> disconnectedOutputs;
+    QList<QPair<Plug*, Plug*>> disconnectedInputs;
+    for(EdgeGroupPair* pair : removedPairs){
+        for(EdgeGroup* group : {pair->getFirstGroup(), pair->getSecondGroup()}){
+            for(PlugEdge* edge : group->getEdges()){
+                Plug* fromPlug = edge->getStartPlug();
+                Plug* toPlug = edge->getEndPlug();
+                fromPlug->removeEdge(edge);
+                toPlug->removeEdge(edge);
+                m_edges.remove(QPair<Plug*, Plug*>(fromPlug, toPlug));
+                removeItem(edge);
+                edge->deleteLater();
+
+                // only remaining Nodes are notified about their lost connections
+                if(!removedNodes.contains(fromPlug->getNode())){
+                    disconnectedOutputs.append(QPair<Plug*, Plug*>(fromPlug, toPlug));
+                }
+                if(!removedNodes.contains(toPlug->getNode())){
+                    disconnectedInputs.append(QPair<Plug*, Plug*>(toPlug, fromPlug));
+                }
+            }
+        }
+
+        // delete the pair with its groups and straight edges
+        Node* firstNode = pair->getFirstGroup()->getFromNode();
+        Node* secondNode = pair->getFirstGroup()->getToNode();
+        m_edgeGroups.remove(qMakePair(firstNode, secondNode));
+        m_edgeGroups.remove(qMakePair(secondNode, firstNode));
+        firstNode->removeEdgeGroupPair(secondNode);
+        secondNode->removeEdgeGroupPair(firstNode);
+        m_edgeGroupPairs.remove(pair);
+        delete pair;
+    }
+
+    // delete all references to the Nodes and finally the Nodes themselves
+    QList<NodeHandle> removedHandles;
+    removedHandles.reserve(removedNodeList.size());
+    for(Node* node : removedNodeList){
+        removedHandles.append(NodeHandle(node));
+        if(m_selectedNodes.contains(node)){
+            nodeSelectionHasChanged(node, false);
+            selectionHasChanged = true;
+        }
+        m_nodes.remove(node);
+        m_nodesById.remove(node->getUniqueId());
+        m_nodeIndex.removeNode(node);
+        removeItem(node);
+        node->deleteLater();
+    }
+
+    // rebuild the index once for the remaining items
+    if(itemIndexMethod()!=previousIndexMethod){
+        setItemIndexMethod(previousIndexMethod);
+    }
+
+    // emit signals, each remaining Node for itself but all lost connections at once through the hub
+    blockSignals(wasBlocked);
+    QList<QPair<PlugHandle, PlugHandle>> disconnections;
+    disconnections.reserve(disconnectedOutputs.size()+disconnectedInputs.size());
+    for(const QPair<Plug*, Plug*>& connection : disconnectedOutputs){
+        emit connection.first->getNode()->outputDisconnected(connection.first, connection.second);
+        disconnections.append(qMakePair(PlugHandle(connection.first), PlugHandle(connection.second)));
+    }
+    for(const QPair<Plug*, Plug*>& connection : disconnectedInputs){
+        emit connection.first->getNode()->inputDisconnected(connection.first, connection.second);
+        disconnections.append(qMakePair(PlugHandle(connection.second), PlugHandle(connection.first)));
+    }
+    if(!disconnections.isEmpty()){
+        emit m_signalHub->plugsDisconnectedInBulk(disconnections);
+    }
+    if(selectionHasChanged){
+        emit selectionChanged();
+    }
+    emit m_signalHub->nodesRemoved(removedHandles);
+    emit nodesRemoved(removedNodeList, removedEdgeCount);
+
+    return removedNodeList.size();
+}
+
+void Scene::clear()
+{
+    // finish the current drag, so all Nodes are top-level items again
+    m_dragLayer->commit();
+    forgetNodes(m_nodes.toList());
+
+    // collect all selection changes and only notify once at the end
+    bool wasBlocked = blockSignals(true);
+    bool selectionHasChanged = !m_selectedNodes.isEmpty();
+    for(Node* node : m_selectedNodes.toList()){
+        nodeSelectionHasChanged(node, false);
+    }
+
+    // labels are top-level items owned by their edge, which must not be deleted by the scene before the edge is
+    for(BaseEdge* edge : getAllEdges()){
+        edge->discardLabel();
+    }
+
+    // every item is deleted, so the registers and indices are cleared as a whole instead of item by item
+    m_edgeIndex.clear();
+    m_nodeIndex.clear();
+    m_nodes.clear();
+    m_nodesById.clear();
+    m_edges.clear();
+    releaseEdgeGroupPairs();
+    m_signalHub->discardChanges();
+
+    // delete all items at once, except for the draw edge and the drag layer
+    removeItem(m_drawEdge);
+    removeItem(m_dragLayer);
+    QGraphicsScene::clear();
+    addItem(m_drawEdge);
+    addItem(m_dragLayer);
+
+    // emit signals
+    blockSignals(wasBlocked);
+    if(selectionHasChanged){
+        emit selectionChanged();
+    }
+}
+
 PlugEdge* Scene::createEdge(Plug* fromPlug, Plug* toPlug)
 {
     // only allow edges between different plugs of different nodes
@@ -95,21 +314,20 @@ PlugEdge* Scene::createEdge(Plug* fromPlug, Plug* toPlug)
     }
 
     // find the edge group for this edge, if it exists
-    uint edgeGroupHash = EdgeGroup::getHashOf(fromNode, toNode);
-    EdgeGroup* edgeGroup;
-    if(m_edgeGroups.contains(edgeGroupHash)){
-        edgeGroup = m_edgeGroups[edgeGroupHash];
-    } else {
+    EdgeGroup* edgeGroup = m_edgeGroups.value(qMakePair(fromNode, toNode), nullptr);
+    if(!edgeGroup){
 
         // ... or create a new edge group pair for it
         EdgeGroupPair* newGroupPair = new EdgeGroupPair(this, fromNode, toNode);
         m_edgeGroupPairs.insert(newGroupPair);
+        fromNode->addEdgeGroupPair(toNode, newGroupPair);
+        toNode->addEdgeGroupPair(fromNode, newGroupPair);
 
         edgeGroup = newGroupPair->getFirstGroup();
-        m_edgeGroups.insert(edgeGroupHash, edgeGroup);
+        m_edgeGroups.insert(qMakePair(fromNode, toNode), edgeGroup);
 
         EdgeGroup* oppositeEdgeGroup = newGroupPair->getSecondGroup();
-        m_edgeGroups.insert(oppositeEdgeGroup->getHash(), oppositeEdgeGroup);
+        m_edgeGroups.insert(qMakePair(toNode, fromNode), oppositeEdgeGroup);
     }
 
     // create the new edge
@@ -119,6 +337,7 @@ PlugEdge* Scene::createEdge(Plug* fromPlug, Plug* toPlug)
     // emit signals
     emit fromNode->outputConnected(fromPlug, toPlug);
     emit toNode->inputConnected(toPlug, fromPlug);
+    emit m_signalHub->plugsConnected(PlugHandle(fromPlug), PlugHandle(toPlug));
 
     return newEdge;
 }
@@ -136,6 +355,9 @@ void Scene::removeEdge(PlugEdge* edge)
     }
 #endif
 
+    // finish the current drag, so the drag layer does not keep a reference to the edge
+    m_dragLayer->commit();
+
     // unregister from the connected plugs
     fromPlug->removeEdge(edge);
     toPlug->removeEdge(edge);
@@ -150,12 +372,14 @@ void Scene::removeEdge(PlugEdge* edge)
     // if the group is now empty, we can only delete it if the other group in the pair is also empty
     EdgeGroupPair* edgeGroupPair = edgeGroup->getEdgeGroupPair();
     if(edgeGroupPair->isEmpty()){
-        uint firstHash = edgeGroupPair->getFirstGroup()->getHash();
-        uint secondHash = edgeGroupPair->getSecondGroup()->getHash();
-        Q_ASSERT(m_edgeGroups.contains(firstHash));
-        Q_ASSERT(m_edgeGroups.contains(secondHash));
-        m_edgeGroups.remove(firstHash);
-        m_edgeGroups.remove(secondHash);
+        Node* firstNode = edgeGroupPair->getFirstGroup()->getFromNode();
+        Node* secondNode = edgeGroupPair->getFirstGroup()->getToNode();
+        Q_ASSERT(m_edgeGroups.contains(qMakePair(firstNode, secondNode)));
+        Q_ASSERT(m_edgeGroups.contains(qMakePair(secondNode, firstNode)));
+        m_edgeGroups.remove(qMakePair(firstNode, secondNode));
+        m_edgeGroups.remove(qMakePair(secondNode, firstNode));
+        firstNode->removeEdgeGroupPair(secondNode);
+        secondNode->removeEdgeGroupPair(firstNode);
         m_edgeGroupPairs.remove(edgeGroupPair);
         delete edgeGroupPair; // also deletes the EdgeGroups
         edgeGroupPair = nullptr;
@@ -170,6 +394,7 @@ void Scene::removeEdge(PlugEdge* edge)
     // emit signals
     emit fromPlug->getNode()->outputDisconnected(fromPlug, toPlug);
     emit toPlug->getNode()->inputDisconnected(toPlug, fromPlug);
+    emit m_signalHub->plugsDisconnected(PlugHandle(fromPlug), PlugHandle(toPlug));
 }
 
 PlugEdge* Scene::getEdge(Plug* fromPlug, Plug* toPlug)
@@ -185,8 +410,103 @@ void Scene::collapseAllNodes()
     }
 }
 
+void Scene::setEdgeIndexMethod(EdgeIndexMethod method)
+{
+    if(method==m_edgeIndexMethod){
+        return;
+    }
+    m_edgeIndexMethod = method;
+
+    // re-register all edges according to the new method
+    for(BaseEdge* edge : getAllEdges()){
+        edge->updateBounds();
+    }
+}
+
+void Scene::setLabelsVisible(bool visible)
+{
+    if(visible==m_areLabelsVisible){
+        return;
+    }
+    m_areLabelsVisible = visible;
+
+    // the labels check the flag when painted, so their item caches have to be discarded
+    for(Node* node : m_nodes){
+        node->updateLabels();
+    }
+    for(BaseEdge* edge : getAllEdges()){
+        edge->updateLabel();
+    }
+}
+
+void Scene::setSpriteAtlasEnabled(bool enabled)
+{
+    if(enabled==m_spriteAtlas.isEnabled()){
+        return;
+    }
+    m_spriteAtlas.setEnabled(enabled);
+    m_cachePolicy.refresh();
+    update();
+}
+
+void Scene::setNodeSelection(const QSet<Node*>& nodes)
+{
+    QSet<Node*> added;
+    for(Node* node : nodes){
+        if(!m_selectedNodes.contains(node)){
+            added.insert(node);
+        }
+    }
+    QSet<Node*> removed;
+    for(Node* node : m_selectedNodes){
+        if(!nodes.contains(node)){
+            removed.insert(node);
+        }
+    }
+    changeNodeSelection(added, removed);
+}
+
+void Scene::changeNodeSelection(const QSet<Node*>& added, const QSet<Node*>& removed)
+{
+    if((added.isEmpty()) && (removed.isEmpty())){
+        return;
+    }
+
+    // collect all selection changes and only notify once at the end
+    bool wasBlocked = blockSignals(true);
+    for(Node* node : removed){
+        node->setSelected(false);
+    }
+    for(Node* node : added){
+        node->setSelected(true);
+    }
+    blockSignals(wasBlocked);
+    emit selectionChanged();
+}
+
+void Scene::nodeSelectionHasChanged(Node* node, bool isSelected)
+{
+    // a change that reverts an unannounced change cancels both out
+    NodeHandle handle(node);
+    if(isSelected){
+        m_selectedNodes.insert(node);
+        if(!m_newlyDeselectedNodes.remove(handle)){
+            m_newlySelectedNodes.insert(handle);
+        }
+    } else {
+        m_selectedNodes.remove(node);
+        if(!m_newlySelectedNodes.remove(handle)){
+            m_newlyDeselectedNodes.insert(handle);
+        }
+    }
+}
+
 void Scene::updateStyle()
 {
+    // sprites and text layouts of the old style are not needed anymore
+    m_spriteAtlas.clear();
+    m_textLayoutCache.clear();
+
     for(Node* node : m_nodes){
         node->updateStyle();
     }
@@ -196,4 +516,67 @@ void Scene::updateStyle()
     m_drawEdge->updateStyle();
 }
 
+void Scene::emitSelectionChange()
+{
+    if(m_newlySelectedNodes.isEmpty() && m_newlyDeselectedNodes.isEmpty()){
+        return;
+    }
+    QList<NodeHandle> selected = m_newlySelectedNodes.toList();
+    QList<NodeHandle> deselected = m_newlyDeselectedNodes.toList();
+    m_newlySelectedNodes.clear();
+    m_newlyDeselectedNodes.clear();
+    emit m_signalHub->selectionChanged(selected, deselected);
+}
+
+void Scene::releaseEdgeGroupPairs()
+{
+    // removing each edge of a pair from the scene separately is slow, let the scene delete them with all other items
+    m_edgeGroups.clear();
+    for(EdgeGroupPair* edgeGroupPair : m_edgeGroupPairs){
+        edgeGroupPair->releaseEdges();
+        delete edgeGroupPair;
+    }
+    m_edgeGroupPairs.clear();
+}
+
+void Scene::forgetNodes(const QList<Node*>& nodes)
+{
+    for(QGraphicsView* view : views()){
+        View* zodiacView = qobject_cast<View*>(view);
+        if(zodiacView){
+            zodiacView->forgetNodes(nodes);
+        }
+    }
+
+    // the static pointers are followed with the next mouse event and must not outlive their Node
+    Plug* dragTargetPlug = Plug::getDragTargetPlug();
+    if((dragTargetPlug) && (nodes.contains(dragTargetPlug->getNode()))){
+        Plug::clearDragTargetPlug();
+    }
+    if(nodes.contains(Plug::getDragTargetNode())){
+        Plug::clearDragTargetNode();
+    }
+    const Plug* closestPlug = Perimeter::getClosestPlugToMouse();
+    if((closestPlug) && (nodes.contains(closestPlug->getNode()))){
+        Perimeter::clearClosestPlugToMouse();
+    }
+}
+
+QList<BaseEdge*> Scene::getAllEdges() const
+{
+    // collect the edges from the registers instead of going through all items in the scene
+    QList<BaseEdge*> result;
+    result.reserve(m_edges.size() + (m_edgeGroupPairs.size()*3) + 1);
+    for(PlugEdge* edge : m_edges){
+        result.append(edge);
+    }
+    for(EdgeGroupPair* pair : m_edgeGroupPairs){
+        result.append(pair->getFirstGroup()->getStraightEdge());
+        result.append(pair->getSecondGroup()->getStraightEdge());
+        result.append(pair->getDoubleEdge());
+    }
+    result.append(m_drawEdge);
+    return result;
+}
+
 } // namespace zodiac
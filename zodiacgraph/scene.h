@@ -38,8 +38,18 @@
 #include <QUuid>
 #include <QSet>
 
+#include "cachepolicy.h"
+#include "edgegeometrybuffer.h"
+#include "edgeindex.h"
+#include "nodeindex.h"
+#include "signalhub.h"
+#include "spriteatlas.h"
+#include "textlayoutcache.h"
+
 namespace zodiac {
 
+class BaseEdge;
+class DragLayer;
 class DrawEdge;
 class PlugEdge;
 class Node;
@@ -47,6 +57,14 @@ class Plug;
 class EdgeGroup;
 class EdgeGroupPair;
 
+///
+/// \brief How the edges of a Scene are spatially indexed.
+///
+enum class EdgeIndexMethod {
+    SCENE_INDEX,    ///< Edges are indexed in the BSP tree of the QGraphicsScene with their (slightly padded) bounds.
+    EDGE_GRID,      ///< Edges report grid-snapped bounds to the QGraphicsScene and are indexed in the EdgeIndex.
+};
+
 ///
 /// \brief Scene class for the ZodiacGraph.
 ///
@@ -87,12 +105,23 @@ public: // methods
     ///
     Node* createNode(const QString& name, const QUuid& uuid = QUuid());
 
+    ///
+    /// \brief Looks up a Node of this Scene by its unique identifier.
+    ///
+    /// \param [in] uuid    Unique identifier of the Node.
+    ///
+    /// \return             The Node with the given identifier or <i>nullptr</i>, if there is none.
+    ///
+    inline Node* getNode(const QUuid& uuid) const {return m_nodesById.value(uuid, nullptr);}
+
     ///
     /// \brief Removes an existing Node from this Scene.
     ///
     /// A Node can only be removed if it has no PlugEdge%s attached to any of its Plug%s.
     /// If you want to test if the Node can be removed prior to calling Scene::removeNode(), use Node::isRemovable().
     ///
+    /// If the user is currently dragging Node%s around, the drag is finished before the Node is removed.
+    ///
     /// Make sure that this Scene actually contains the given Node.
     /// If it doesn't, calling this function returns <i>false</i> in release mode and will throw an assertion error
     /// in debug mode.
@@ -105,6 +134,49 @@ public: // methods
     ///
     bool removeNode(Node* node);
 
+    ///
+    /// \brief Removes multiple Node%s from this Scene together with all PlugEdge%s attached to them.
+    ///
+    /// Other than Scene::removeNode(), this function also removes Node%s that are still connected.
+    /// All affected EdgeGroupPair%s are deleted once as a whole instead of being updated for each removed PlugEdge, and
+    /// if enough items are removed at once, the item index of the scene is only rebuilt once at the end.
+    ///
+    /// Remaining Node%s that lose a connection still emit their disconnection signals, the removed Node%s do not.
+    /// The SignalHub announces all lost connections at once through SignalHub::plugsDisconnectedInBulk() instead of
+    /// SignalHub::plugsDisconnected().
+    /// Afterwards, Scene::nodesRemoved() is emitted once for all removed Node%s.
+    ///
+    /// If the user is currently dragging Node%s around, the drag is finished before the Node%s are removed.
+    ///
+    /// Make sure that this Scene actually contains all given Node%s.
+    /// If it doesn't, calling this function will throw an assertion error in debug mode and skip the unknown Node%s in
+    /// release mode.
+    ///
+    /// After calling this function, all remaining pointers to the removed Node%s are to be discarded without further
+    /// use.
+    ///
+    /// \param [in] nodes   Node%s to remove.
+    ///
+    /// \return             Number of removed Node%s.
+    ///
+    int removeNodes(const QList<Node*>& nodes);
+
+    ///
+    /// \brief Removes and deletes all Node%s and edges from this Scene.
+    ///
+    /// Since every item is destroyed, the per-item bookkeeping of Scene::removeNode() and Scene::removeEdge() is
+    /// skipped: the registers and indices are cleared as a whole and all items are deleted at once.
+    /// No connection signals are emitted, only QGraphicsScene::selectionChanged() if there was a selection.
+    /// Changes that were not yet emitted as a ChangeSet are discarded.
+    ///
+    /// Hides QGraphicsScene::clear(), which must not be called on a Scene directly, since it would also delete the
+    /// DrawEdge and the DragLayer.
+    ///
+    /// After calling this function, all remaining pointers to Node%s, Plug%s and edges of the Scene are to be
+    /// discarded without further use.
+    ///
+    void clear();
+
     ///
     /// \brief Returns all Node%s managed by the Scene.
     ///
@@ -135,6 +207,8 @@ public: // methods
     ///
     /// Also takes care of deleting EdgeGroup and EdgeGroupPair instances that are empty after removing the PlugEdge.
     ///
+    /// If the user is currently dragging Node%s around, the drag is finished before the PlugEdge is removed.
+    ///
     /// Make sure that this Scene actually contains the given PlugEdge.
     /// If it doesn't, calling this function will throw an assertion error in debug mode and do nothing in release mode.
     ///
@@ -165,11 +239,197 @@ public: // methods
     ///
     inline DrawEdge* getDrawEdge() {return m_drawEdge;}
 
+    ///
+    /// \brief Returns the DragLayer used to move selected Node%s in the scene.
+    ///
+    /// \return         The DragLayer used to move selected Node%s in the scene.
+    ///
+    inline DragLayer* getDragLayer() {return m_dragLayer;}
+
+    ///
+    /// \brief Returns the EdgeGeometryBuffer used to update many PlugEdge%s of the scene at once.
+    ///
+    /// \return         The EdgeGeometryBuffer of the scene.
+    ///
+    inline EdgeGeometryBuffer& getEdgeGeometryBuffer() {return m_edgeGeometryBuffer;}
+
+    ///
+    /// \brief Returns the spatial index of all Node%s in the scene.
+    ///
+    /// \return         The NodeIndex of the scene.
+    ///
+    inline NodeIndex& getNodeIndex() {return m_nodeIndex;}
+
+    ///
+    /// \brief Returns the spatial index of the edges in the scene.
+    ///
+    /// Only contains edges, if the scene uses EdgeIndexMethod::EDGE_GRID.
+    ///
+    /// \return         The EdgeIndex of the scene.
+    ///
+    inline EdgeIndex& getEdgeIndex() {return m_edgeIndex;}
+
+    ///
+    /// \brief Returns how the edges of the scene are spatially indexed.
+    ///
+    /// \return         The EdgeIndexMethod of the scene.
+    ///
+    inline EdgeIndexMethod getEdgeIndexMethod() const {return m_edgeIndexMethod;}
+
+    ///
+    /// \brief Defines how the edges of the scene are spatially indexed.
+    ///
+    /// EdgeIndexMethod::EDGE_GRID is recommended for large scenes, in which many long edges are moved at once.
+    ///
+    /// \param [in] method  New EdgeIndexMethod of the scene.
+    ///
+    void setEdgeIndexMethod(EdgeIndexMethod method);
+
+    ///
+    /// \brief Whether the labels of Node%s, Plug%s and edges in the scene are shown.
+    ///
+    /// \return         <i>true</i> if the labels are shown -- <i>false</i> if they are hidden.
+    ///
+    inline bool areLabelsVisible() const {return m_areLabelsVisible;}
+
+    ///
+    /// \brief Shows or hides all labels in the scene at once.
+    ///
+    /// Is used by the View to skip drawing labels, while it renders in draft quality.
+    /// The labels are not hidden as items, instead they check this flag when they are painted.
+    /// Changing it repaints each label and discards its item cache, so no label is drawn from a cache that was
+    /// created with the other state.
+    ///
+    /// \param [in] visible <i>true</i> to show all labels -- <i>false</i> to hide them.
+    ///
+    void setLabelsVisible(bool visible);
+
+    ///
+    /// \brief Returns the policy deciding how the items of the scene are cached.
+    ///
+    /// \return         The CachePolicy of the scene.
+    ///
+    inline CachePolicy& getCachePolicy() {return m_cachePolicy;}
+
+    ///
+    /// \brief Returns the shared sprites of Node cores and Plug%s in the scene.
+    ///
+    /// \return         The SpriteAtlas of the scene.
+    ///
+    inline SpriteAtlas& getSpriteAtlas() {return m_spriteAtlas;}
+
+    ///
+    /// \brief Defines whether Node cores and Plug%s are drawn from shared sprites.
+    ///
+    /// If disabled, each Node and Plug is cached according to the CachePolicy instead.
+    ///
+    /// \param [in] enabled <i>true</i> to draw from shared sprites -- <i>false</i> to draw each item by itself.
+    ///
+    void setSpriteAtlasEnabled(bool enabled);
+
+    ///
+    /// \brief Returns the shared text layouts of the labels in the scene.
+    ///
+    /// \return         The TextLayoutCache of the scene.
+    ///
+    inline TextLayoutCache& getTextLayoutCache() {return m_textLayoutCache;}
+
+    ///
+    /// \brief Returns the hub emitting all notifications about the Node%s and Plug%s of the scene.
+    ///
+    /// \return         The SignalHub of the scene.
+    ///
+    inline SignalHub* getSignalHub() const {return m_signalHub;}
+
+    ///
+    /// \brief Replaces the current selection with the given Node%s.
+    ///
+    /// Emits QGraphicsScene::selectionChanged() only once, instead of once for each Node whose selection changed.
+    /// Only the Node%s whose selection actually changes are touched, see changeNodeSelection().
+    ///
+    /// \param [in] nodes   Node%s to select, all other items of the scene are deselected.
+    ///
+    void setNodeSelection(const QSet<Node*>& nodes);
+
+    ///
+    /// \brief Selects and deselects the given Node%s, leaving the selection of all others untouched.
+    ///
+    /// Emits QGraphicsScene::selectionChanged() only once and only if any Node was given.
+    ///
+    /// \param [in] added      Node%s to select.
+    /// \param [in] removed    Node%s to deselect.
+    ///
+    void changeNodeSelection(const QSet<Node*>& added, const QSet<Node*>& removed);
+
+    ///
+    /// \brief All selected Node%s of the scene.
+    ///
+    /// Node%s are the only selectable items, so this is the complete selection of the scene, without having to go
+    /// through QGraphicsScene::selectedItems().
+    ///
+    /// \return         The currently selected Node%s.
+    ///
+    inline const QSet<Node*>& getSelectedNodes() const {return m_selectedNodes;}
+
+    ///
+    /// \brief Is called by a Node, whenever it was selected or deselected.
+    ///
+    /// The change is collected and announced through SignalHub::selectionChanged(), once the scene emits
+    /// QGraphicsScene::selectionChanged().
+    ///
+    /// \param [in] node        Node whose selection has changed.
+    /// \param [in] isSelected  <i>true</i>, if the Node is now selected -- <i>false</i> otherwise.
+    ///
+    void nodeSelectionHasChanged(Node* node, bool isSelected);
+
     ///
     /// \brief Initiates a cascade of style updates of the complete Scene.
     ///
     void updateStyle();
 
+signals:
+
+    ///
+    /// \brief Emitted once after Scene::removeNodes() has removed Node%s from the Scene.
+    ///
+    /// The Node%s are no longer part of the Scene, but are only deleted with the next pass of the event loop.
+    ///
+    /// \param [out] nodes          All removed Node%s.
+    /// \param [out] removedEdges   Number of PlugEdge%s removed together with the Node%s.
+    ///
+    void nodesRemoved(QList<zodiac::Node*> nodes, int removedEdges);
+
+private: // methods
+
+    ///
+    /// \brief Deletes all EdgeGroupPair%s, leaving their edges in the scene to be deleted with all other items.
+    ///
+    void releaseEdgeGroupPairs();
+
+    ///
+    /// \brief Collects all edges of the scene from its registers.
+    ///
+    /// \return All PlugEdge%s, the StraightEdge%s and StraightDoubleEdge%s of all EdgeGroupPair%s and the DrawEdge.
+    ///
+    QList<BaseEdge*> getAllEdges() const;
+
+    ///
+    /// \brief Removes all references to Node%s outside of the scene's registers, before the Node%s are deleted.
+    ///
+    /// Clears the rubberband selections of all View%s of the scene, as well as the Plug%s and Node%s targeted by an
+    /// edge-drag or highlighted by a Perimeter, if they belong to one of the Node%s.
+    ///
+    /// \param [in] nodes   Node%s that are removed from the scene.
+    ///
+    void forgetNodes(const QList<Node*>& nodes);
+
+private slots:
+
+    ///
+    /// \brief Announces the selection changes collected since the last call through the SignalHub.
+    ///
+    void emitSelectionChange();
+
 private: // members
 
     ///
@@ -177,11 +437,36 @@ private: // members
     ///
     DrawEdge* m_drawEdge;
 
+    ///
+    /// \brief Layer moving all selected Node%s at once while they are dragged by the user.
+    ///
+    DragLayer* m_dragLayer;
+
     ///
     /// \brief All Node instances in the graph.
     ///
     QSet<Node*> m_nodes;
 
+    ///
+    /// \brief All Node%s in the graph, identified by their unique identifier.
+    ///
+    QHash<QUuid, Node*> m_nodesById;
+
+    ///
+    /// \brief All selected Node%s.
+    ///
+    QSet<Node*> m_selectedNodes;
+
+    ///
+    /// \brief Node%s that were selected since the last selection change was announced.
+    ///
+    QSet<NodeHandle> m_newlySelectedNodes;
+
+    ///
+    /// \brief Node%s that were deselected since the last selection change was announced.
+    ///
+    QSet<NodeHandle> m_newlyDeselectedNodes;
+
     ///
     /// \brief All PlugEdge instances in the graph.
     ///
@@ -190,16 +475,62 @@ private: // members
     ///
     /// \brief All EdgeGroup instances of the scene.
     ///
-    /// EdgeGroup instances are stored in a hashmap with a hash value generated from EdgeGroup::getHashOf() as key.
+    /// EdgeGroup instances are stored in a hashmap with the pair of start and end Node as key.
     /// This way we can easily find the EdgeGroup for a directed connection between to Node%s in the graph.
+    /// The key is compared exactly, so distinct pairs of Node%s never share an EdgeGroup, even if their hashes collide.
     ///
-    QHash<uint, EdgeGroup*> m_edgeGroups;
+    QHash<QPair<Node*, Node*>, EdgeGroup*> m_edgeGroups;
 
     ///
     /// \brief All EdgeGroupPair%s owned by the scene.
     ///
     QSet<EdgeGroupPair*> m_edgeGroupPairs;
 
+    ///
+    /// \brief Reusable buffer to update the geometry of many PlugEdge%s at once.
+    ///
+    EdgeGeometryBuffer m_edgeGeometryBuffer;
+
+    ///
+    /// \brief Spatial index of all Node%s in the scene.
+    ///
+    NodeIndex m_nodeIndex;
+
+    ///
+    /// \brief Spatial index of the edges in the scene.
+    ///
+    EdgeIndex m_edgeIndex;
+
+    ///
+    /// \brief How the edges of the scene are spatially indexed.
+    ///
+    EdgeIndexMethod m_edgeIndexMethod;
+
+    ///
+    /// \brief Whether the labels in the scene are shown.
+    ///
+    bool m_areLabelsVisible;
+
+    ///
+    /// \brief Decides how the items of the scene are cached.
+    ///
+    CachePolicy m_cachePolicy;
+
+    ///
+    /// \brief Shared sprites of Node cores and Plug%s.
+    ///
+    SpriteAtlas m_spriteAtlas;
+
+    ///
+    /// \brief Shared text layouts of the labels in the scene.
+    ///
+    TextLayoutCache m_textLayoutCache;
+
+    ///
+    /// \brief Emits the notifications of all Node%s and Plug%s of the scene, is owned by the scene.
+    ///
+    SignalHub* m_signalHub;
+
 };
 
 } // namespace zodiac
@@ -36,6 +36,37 @@ NodeHandle SceneHandle::createNode(const QString& name, const QUuid& uuid)
     return NodeHandle(m_scene->createNode(name, uuid));
 }
 
+int SceneHandle::removeNodes(const QList<NodeHandle>& nodes)
+{
+#ifdef QT_DEBUG
+    Q_ASSERT(m_isValid);
+#else
+    if(!m_isValid){
+        return 0;
+    }
+#endif
+    QList<Node*> removedNodes;
+    removedNodes.reserve(nodes.size());
+    for(const NodeHandle& node : nodes){
+        if(node.isValid()){
+            removedNodes.append(node.data());
+        }
+    }
+    return m_scene->removeNodes(removedNodes);
+}
+
+void SceneHandle::clear()
+{
+#ifdef QT_DEBUG
+    Q_ASSERT(m_isValid);
+#else
+    if(!m_isValid){
+        return;
+    }
+#endif
+    m_scene->clear();
+}
+
 QList<NodeHandle> SceneHandle::getNodes() const
 {
     QList<NodeHandle> result;
@@ -54,7 +85,49 @@ QList<NodeHandle> SceneHandle::getNodes() const
     return result;
 }
 
-void SceneHandle::deselectAll() const
+QList<NodeHandle> SceneHandle::getNodesInRect(const QRectF& rect) const
+{
+    QList<NodeHandle> result;
+#ifdef QT_DEBUG
+    Q_ASSERT(m_isValid);
+#else
+    if(!m_isValid){
+        return result;
+    }
+#endif
+    QList<Node*> nodes = m_scene->getNodeIndex().getNodesInRect(rect);
+    result.reserve(nodes.size());
+    for(Node* node : nodes){
+        result.append(NodeHandle(node));
+    }
+    return result;
+}
+
+NodeHandle SceneHandle::getNearestNode(const QPointF& pos) const
+{
+#ifdef QT_DEBUG
+    Q_ASSERT(m_isValid);
+#else
+    if(!m_isValid){
+        return NodeHandle();
+    }
+#endif
+    return NodeHandle(m_scene->getNodeIndex().getNearestNode(pos));
+}
+
+SignalHub* SceneHandle::getSignalHub() const
+{
+#ifdef QT_DEBUG
+    Q_ASSERT(m_isValid);
+#else
+    if(!m_isValid){
+        return nullptr;
+    }
+#endif
+    return m_scene->getSignalHub();
+}
+
+void SceneHandle::setChangeSetsEnabled(bool enabled)
 {
 #ifdef QT_DEBUG
     Q_ASSERT(m_isValid);
@@ -63,9 +136,19 @@ void SceneHandle::deselectAll() const
         return;
     }
 #endif
-    for(QGraphicsItem* item : m_scene->selectedItems()){
-        item->setSelected(false);
+    m_scene->getSignalHub()->setChangeSetsEnabled(enabled);
+}
+
+void SceneHandle::deselectAll() const
+{
+#ifdef QT_DEBUG
+    Q_ASSERT(m_isValid);
+#else
+    if(!m_isValid){
+        return;
     }
+#endif
+    m_scene->clearSelection();
 }
 
 void SceneHandle::connectSignals()
@@ -75,20 +158,39 @@ void SceneHandle::connectSignals()
     }
     connect(m_scene, SIGNAL(destroyed()), this, SLOT(sceneWasDestroyed()));
     connect(m_scene, SIGNAL(selectionChanged()), this, SLOT(updateSelection()));
+    connect(m_scene, SIGNAL(nodesRemoved(QList<zodiac::Node*>, int)),
+            this, SLOT(passNodesRemoved(QList<zodiac::Node*>, int)));
+    connect(m_scene->getSignalHub(), SIGNAL(changeSetReady(zodiac::ChangeSet)),
+            this, SIGNAL(changeSetReady(zodiac::ChangeSet)));
+    connect(m_scene->getSignalHub(), SIGNAL(selectionChanged(QList<zodiac::NodeHandle>, QList<zodiac::NodeHandle>)),
+            this, SIGNAL(selectionChanged(QList<zodiac::NodeHandle>, QList<zodiac::NodeHandle>)));
 }
 
 void SceneHandle::updateSelection()
 {
+    // only build the complete selection if anyone is interested in it
+    if(receivers(SIGNAL(selectionChanged(QList<zodiac::NodeHandle>)))==0){
+        return;
+    }
+    const QSet<Node*>& selectedNodes = m_scene->getSelectedNodes();
     QList<NodeHandle> selection;
-    for(QGraphicsItem* item : m_scene->selectedItems()){
-        Node* selectedNode = qobject_cast<Node*>(item->toGraphicsObject());
-        if(selectedNode){
-            selection.append(NodeHandle(selectedNode));
-        }
+    selection.reserve(selectedNodes.size());
+    for(Node* selectedNode : selectedNodes){
+        selection.append(NodeHandle(selectedNode));
     }
     emit selectionChanged(selection);
 }
 
+void SceneHandle::passNodesRemoved(QList<Node*> nodes, int removedEdges)
+{
+    QList<NodeHandle> removedNodes;
+    removedNodes.reserve(nodes.size());
+    for(Node* node : nodes){
+        removedNodes.append(NodeHandle(node));
+    }
+    emit nodesRemoved(removedNodes, removedEdges);
+}
+
 void SceneHandle::sceneWasDestroyed()
 {
     m_isValid = false;
@@ -33,9 +33,12 @@
 
 #include <QObject>
 #include <QHash>
+#include <QPointF>
+#include <QRectF>
 #include <QUuid>
 
 #include "nodehandle.h"
+#include "signalhub.h"
 
 namespace zodiac {
 
@@ -61,8 +64,9 @@ class Scene;
 /// Keeping a shared pointer on a QGraphicsItem after its QGraphicsScene was removed will cause a segmentation error to
 /// occur and although you could completely separate the logical and graphical code (with a complete overhaul of the
 /// architecture and rewrite of the code), I will leave this exercise for subsequent versions. <br>
-/// Instead each handle listens to its respective QObject and sets its internal pointer to <i>nullptr</i>, as soon as it
-/// receives the "deleted()" signal.
+/// Instead each NodeHandle and PlugHandle holds a weak reference (a QPointer) to its respective QObject, which Qt
+/// resets as soon as the object is deleted.
+/// The SceneHandle still listens to the "destroyed()" signal of its Scene.
 /// In the meantime, this approach should cover 99% of all use-cases, as long as you don't access the graph using
 /// multiple threads at once.
 ///
@@ -130,6 +134,26 @@ public: // methods
     ///
     NodeHandle createNode(const QString& name, const QUuid& uuid = QUuid());
 
+    ///
+    /// \brief Removes multiple Node%s from the zodiac graph, including all of their connections.
+    ///
+    /// Other than NodeHandle::remove(), this also removes Node%s that are still connected to other Node%s.
+    /// All Node%s are removed in a single pass, after which SceneHandle::nodesRemoved() is emitted once.
+    ///
+    /// \param [in] nodes   Handles of the Node%s to remove.
+    ///
+    /// \return             Number of removed Node%s.
+    ///
+    int removeNodes(const QList<NodeHandle>& nodes);
+
+    ///
+    /// \brief Removes all Node%s and their connections from the zodiac graph at once.
+    ///
+    /// Much faster than removing the Node%s one by one, but does not emit any connection signals.
+    /// All NodeHandle%s and PlugHandle%s of the Scene become invalid.
+    ///
+    void clear();
+
     ///
     /// \brief Returns all Node%s managed by the Scene.
     ///
@@ -137,6 +161,44 @@ public: // methods
     ///
     QList<NodeHandle> getNodes() const;
 
+    ///
+    /// \brief Returns all Node%s whose Perimeter intersects the given rectangle.
+    ///
+    /// \param [in] rect    Rectangle in scene coordinates.
+    ///
+    /// \return             Handles to all Node%s in the rectangle.
+    ///
+    QList<NodeHandle> getNodesInRect(const QRectF& rect) const;
+
+    ///
+    /// \brief Returns the Node whose center is closest to the given position.
+    ///
+    /// \param [in] pos     Position in scene coordinates.
+    ///
+    /// \return             Handle to the nearest Node, is invalid if the Scene is empty.
+    ///
+    NodeHandle getNearestNode(const QPointF& pos) const;
+
+    ///
+    /// \brief Returns the hub emitting all notifications about the Node%s and Plug%s of the Scene.
+    ///
+    /// Connect to the hub once, instead of connecting to each Node or Plug.
+    ///
+    /// \return The SignalHub of the Scene or <i>nullptr</i>, if the handle is invalid.
+    ///
+    SignalHub* getSignalHub() const;
+
+    ///
+    /// \brief Enables or disables the coalescing of all changes in the Scene into ChangeSet%s.
+    ///
+    /// If enabled, SceneHandle::changeSetReady() is emitted once per pass of the event loop with all changes to the
+    /// Node%s, Plug%s and connections of the Scene.
+    /// This is an alternative to reacting to each single signal of the SignalHub, which is still emitted as well.
+    ///
+    /// \param [in] enabled <i>true</i> to enable ChangeSet%s -- <i>false</i> to disable them.
+    ///
+    void setChangeSetsEnabled(bool enabled);
+
     ///
     /// \brief Clears the selection of the Scene.
     ///
@@ -151,6 +213,34 @@ signals:
     ///
     void selectionChanged(QList<zodiac::NodeHandle> selection);
 
+    ///
+    /// \brief Emitted when the selection in the Scene has changed, containing only the changed Node%s.
+    ///
+    /// Unlike selectionChanged(QList<zodiac::NodeHandle>), the cost of this signal does not grow with the size of
+    /// the selection.
+    ///
+    /// \param [out] selected   Handles to Node%s that were added to the selection.
+    /// \param [out] deselected Handles to Node%s that were removed from the selection.
+    ///
+    void selectionChanged(QList<zodiac::NodeHandle> selected, QList<zodiac::NodeHandle> deselected);
+
+    ///
+    /// \brief Emitted once after SceneHandle::removeNodes() has removed Node%s from the Scene.
+    ///
+    /// The handles are about to become invalid, but can still be used to identify the removed Node%s.
+    ///
+    /// \param [out] nodes          Handles to all removed Node%s.
+    /// \param [out] removedEdges   Number of connections removed together with the Node%s.
+    ///
+    void nodesRemoved(QList<zodiac::NodeHandle> nodes, int removedEdges);
+
+    ///
+    /// \brief Emitted once per pass of the event loop with all changes in the Scene, if ChangeSet%s are enabled.
+    ///
+    /// \param [out] changeSet  All changes since the last ChangeSet was emitted.
+    ///
+    void changeSetReady(zodiac::ChangeSet changeSet);
+
 private: // methods
 
     ///
@@ -165,6 +255,14 @@ private slots:
     ///
     void updateSelection();
 
+    ///
+    /// \brief Called, when Node%s were removed from the Scene in bulk.
+    ///
+    /// \param [in] nodes           All removed Node%s.
+    /// \param [in] removedEdges    Number of PlugEdge%s removed together with the Node%s.
+    ///
+    void passNodesRemoved(QList<zodiac::Node*> nodes, int removedEdges);
+
     ///
     /// \brief Called, when the mangaged Scene was destroyed.
     ///
@@ -0,0 +1,180 @@
+#include "signalhub.h"
+
+#include <QMetaObject>
+
+namespace zodiac {
+
+SignalHub::SignalHub(QObject* parent)
+    : QObject(parent)
+    , m_areChangeSetsEnabled(false)
+    , m_isChangeSetScheduled(false)
+    , m_changeSet(ChangeSet())
+    , m_connections(QHash<QPair<Plug*, Plug*>, QPair<PlugHandle, PlugHandle>>())
+    , m_disconnections(QHash<QPair<Plug*, Plug*>, QPair<PlugHandle, PlugHandle>>())
+{
+}
+
+void SignalHub::setChangeSetsEnabled(bool enabled)
+{
+    if(enabled==m_areChangeSetsEnabled){
+        return;
+    }
+    m_areChangeSetsEnabled = enabled;
+
+    if(!enabled){
+        // the hub only connects to itself for recording
+        disconnect(this, nullptr, this, nullptr);
+        discardChanges();
+        return;
+    }
+
+    connect(this, SIGNAL(nodeCreated(zodiac::NodeHandle)), this, SLOT(recordNodeCreated(zodiac::NodeHandle)));
+    connect(this, SIGNAL(nodesRemoved(QList<zodiac::NodeHandle>)),
+            this, SLOT(recordNodesRemoved(QList<zodiac::NodeHandle>)));
+    connect(this, SIGNAL(nodeRenamed(zodiac::NodeHandle, QString)), this, SLOT(recordNodeRenamed(zodiac::NodeHandle)));
+    connect(this, SIGNAL(nodeMoved(zodiac::NodeHandle)), this, SLOT(recordNodeMoved(zodiac::NodeHandle)));
+    connect(this, SIGNAL(plugCreated(zodiac::PlugHandle)), this, SLOT(recordPlugCreated(zodiac::PlugHandle)));
+    connect(this, SIGNAL(plugRemoved(zodiac::PlugHandle)), this, SLOT(recordPlugRemoved(zodiac::PlugHandle)));
+    connect(this, SIGNAL(plugRenamed(zodiac::PlugHandle, QString)), this, SLOT(recordPlugRenamed(zodiac::PlugHandle)));
+    connect(this, SIGNAL(plugsConnected(zodiac::PlugHandle, zodiac::PlugHandle)),
+            this, SLOT(recordPlugsConnected(zodiac::PlugHandle, zodiac::PlugHandle)));
+    connect(this, SIGNAL(plugsDisconnected(zodiac::PlugHandle, zodiac::PlugHandle)),
+            this, SLOT(recordPlugsDisconnected(zodiac::PlugHandle, zodiac::PlugHandle)));
+}
+
+void SignalHub::discardChanges()
+{
+    m_changeSet = ChangeSet();
+    m_connections.clear();
+    m_disconnections.clear();
+}
+
+void SignalHub::scheduleChangeSet()
+{
+    if(m_isChangeSetScheduled){
+        return;
+    }
+    m_isChangeSetScheduled = true;
+    QMetaObject::invokeMethod(this, "emitChangeSet", Qt::QueuedConnection);
+}
+
+void SignalHub::recordNodeCreated(NodeHandle node)
+{
+    m_changeSet.renamedNodes.remove(node);
+    m_changeSet.movedNodes.remove(node);
+    m_changeSet.createdNodes.insert(node);
+    scheduleChangeSet();
+}
+
+void SignalHub::recordNodesRemoved(QList<NodeHandle> nodes)
+{
+    QSet<Plug*> removedPlugs;
+    for(const NodeHandle& node : nodes){
+        m_changeSet.renamedNodes.remove(node);
+        m_changeSet.movedNodes.remove(node);
+        for(const PlugHandle& plug : node.getPlugs()){
+            m_changeSet.createdPlugs.remove(plug);
+            m_changeSet.renamedPlugs.remove(plug);
+            removedPlugs.insert(plug.data());
+        }
+
+        // a Node created during the same pass has never been announced
+        if(!m_changeSet.createdNodes.remove(node)){
+            m_changeSet.removedNodes.insert(node);
+        }
+    }
+
+    // connections of the removed Plugs are gone with their Nodes and are not listed separately
+    for(QHash<QPair<Plug*, Plug*>, QPair<PlugHandle, PlugHandle>>* connections : {&m_connections, &m_disconnections}){
+        QHash<QPair<Plug*, Plug*>, QPair<PlugHandle, PlugHandle>>::iterator it = connections->begin();
+        while(it!=connections->end()){
+            if(removedPlugs.contains(it.key().first) || removedPlugs.contains(it.key().second)){
+                it = connections->erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+    scheduleChangeSet();
+}
+
+void SignalHub::recordNodeRenamed(NodeHandle node)
+{
+    if(!m_changeSet.createdNodes.contains(node)){
+        m_changeSet.renamedNodes.insert(node);
+        scheduleChangeSet();
+    }
+}
+
+void SignalHub::recordNodeMoved(NodeHandle node)
+{
+    if(!m_changeSet.createdNodes.contains(node)){
+        m_changeSet.movedNodes.insert(node);
+        scheduleChangeSet();
+    }
+}
+
+void SignalHub::recordPlugCreated(PlugHandle plug)
+{
+    m_changeSet.createdPlugs.insert(plug);
+    scheduleChangeSet();
+}
+
+void SignalHub::recordPlugRemoved(PlugHandle plug)
+{
+    m_changeSet.renamedPlugs.remove(plug);
+
+    // a Plug created during the same pass has never been announced
+    if(!m_changeSet.createdPlugs.remove(plug)){
+        m_changeSet.removedPlugs.insert(plug);
+    }
+    scheduleChangeSet();
+}
+
+void SignalHub::recordPlugRenamed(PlugHandle plug)
+{
+    if(!m_changeSet.createdPlugs.contains(plug)){
+        m_changeSet.renamedPlugs.insert(plug);
+        scheduleChangeSet();
+    }
+}
+
+void SignalHub::recordPlugsConnected(PlugHandle output, PlugHandle input)
+{
+    // re-creating a connection that was removed during the same pass changes nothing
+    QPair<Plug*, Plug*> key(output.data(), input.data());
+    if(!m_disconnections.remove(key)){
+        m_connections.insert(key, QPair<PlugHandle, PlugHandle>(output, input));
+    }
+    scheduleChangeSet();
+}
+
+void SignalHub::recordPlugsDisconnected(PlugHandle output, PlugHandle input)
+{
+    // removing a connection that was created during the same pass changes nothing
+    QPair<Plug*, Plug*> key(output.data(), input.data());
+    if(!m_connections.remove(key)){
+        m_disconnections.insert(key, QPair<PlugHandle, PlugHandle>(output, input));
+    }
+    scheduleChangeSet();
+}
+
+void SignalHub::emitChangeSet()
+{
+    m_isChangeSetScheduled = false;
+    if(!m_areChangeSetsEnabled){
+        return;
+    }
+
+    // start a new set before emitting, in case the receivers change the Scene
+    ChangeSet changeSet = m_changeSet;
+    changeSet.connections = m_connections.values();
+    changeSet.disconnections = m_disconnections.values();
+    discardChanges();
+
+    if(!changeSet.isEmpty()){
+        emit changeSetReady(changeSet);
+    }
+}
+
+} // namespace zodiac
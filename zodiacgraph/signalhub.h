@@ -0,0 +1,356 @@
+//
+//    ZodiacGraph - A general-purpose, circular node graph UI module.
+//    Copyright (C) 2015  Clemens Sielaff
+//
+//    The MIT License
+//
+//    Permission is hereby granted, free of charge, to any person obtaining a copy of
+//    this software and associated documentation files (the "Software"), to deal in
+//    the Software without restriction, including without limitation the rights to
+//    use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+//    of the Software, and to permit persons to whom the Software is furnished to do so,
+//    subject to the following conditions:
+//
+//    The above copyright notice and this permission notice shall be included in all
+//    copies or substantial portions of the Software.
+//
+//    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//    SOFTWARE.
+//
+
+#ifndef ZODIAC_SIGNALHUB_H
+#define ZODIAC_SIGNALHUB_H
+
+///
+/// \file signalhub.h
+///
+/// \brief Contains the definition of the zodiac::SignalHub class.
+///
+
+#include <QHash>
+#include <QList>
+#include <QObject>
+#include <QPair>
+#include <QSet>
+
+#include "nodehandle.h"
+#include "plughandle.h"
+
+namespace zodiac {
+
+///
+/// \brief All changes to the Node%s and Plug%s of a Scene during one pass of the event loop.
+///
+/// Changes that cancel each other out are not part of the set, for example a Node that was created and removed again.
+/// Node%s and Plug%s that were created or removed are not listed as renamed or moved as well.
+/// Plug%s removed together with their Node are not listed separately, neither are the connections of those Plug%s.
+///
+struct ChangeSet {
+    QSet<NodeHandle> createdNodes;  ///< Node%s created during the pass.
+    QSet<NodeHandle> removedNodes;  ///< Node%s removed during the pass, their handles are about to become invalid.
+    QSet<NodeHandle> renamedNodes;  ///< Existing Node%s that were renamed.
+    QSet<NodeHandle> movedNodes;    ///< Existing Node%s that were moved.
+    QSet<PlugHandle> createdPlugs;  ///< Plug%s created during the pass.
+    QSet<PlugHandle> removedPlugs;  ///< Plug%s removed during the pass, their handles are about to become invalid.
+    QSet<PlugHandle> renamedPlugs;  ///< Existing Plug%s that were renamed.
+    QList<QPair<PlugHandle, PlugHandle>> connections;       ///< New connections as pairs of (output, input).
+    QList<QPair<PlugHandle, PlugHandle>> disconnections;    ///< Removed connections as pairs of (output, input).
+
+    ///
+    /// \brief Tests whether there are no changes in this set.
+    ///
+    /// \return <i>true</i> if nothing has changed -- <i>false</i> otherwise.
+    ///
+    inline bool isEmpty() const {return createdNodes.isEmpty() && removedNodes.isEmpty() && renamedNodes.isEmpty()
+                && movedNodes.isEmpty() && createdPlugs.isEmpty() && removedPlugs.isEmpty() && renamedPlugs.isEmpty()
+                && connections.isEmpty() && disconnections.isEmpty();}
+};
+
+///
+/// \brief Single source of all notifications about the Node%s and Plug%s of a Scene.
+///
+/// NodeHandle%s and PlugHandle%s are lightweight values that cannot emit signals by themselves.
+/// Instead, each Scene owns a single SignalHub, which emits the signals of all of its Node%s and Plug%s together with
+/// handles of the objects concerned.
+/// Connect to it once through SceneHandle::getSignalHub() and dispatch by handle, instead of connecting to every
+/// single Node.
+///
+/// Additionally, the hub can coalesce all changes into a single ChangeSet, which is emitted once per pass of the event
+/// loop.
+/// This is disabled by default, as it requires each change to be recorded.
+/// Bulk operations, which cause thousands of signals in a row, can then be applied by their receivers in one go.
+///
+class SignalHub : public QObject
+{
+
+    Q_OBJECT
+
+public: // methods
+
+    ///
+    /// \brief Constructor.
+    ///
+    /// \param [in] parent  Qt parent, is the Scene owning this hub.
+    ///
+    explicit SignalHub(QObject* parent);
+
+    ///
+    /// \brief Whether changes are coalesced into ChangeSet%s or not.
+    ///
+    /// \return <i>true</i>, if SignalHub::changeSetReady() is emitted -- <i>false</i> otherwise.
+    ///
+    inline bool areChangeSetsEnabled() const {return m_areChangeSetsEnabled;}
+
+    ///
+    /// \brief Enables or disables the coalescing of changes into ChangeSet%s.
+    ///
+    /// Disabling the ChangeSet%s discards all changes that were not emitted yet.
+    ///
+    /// \param [in] enabled <i>true</i> to emit SignalHub::changeSetReady() once per pass of the event loop.
+    ///
+    void setChangeSetsEnabled(bool enabled);
+
+    ///
+    /// \brief Discards all changes that were not emitted yet.
+    ///
+    /// Is called by the Scene, when all of its Node%s are deleted at once.
+    ///
+    void discardChanges();
+
+signals:
+
+    ///
+    /// \brief Is emitted, when a Node was created.
+    ///
+    /// \param [out] node   The new Node.
+    ///
+    void nodeCreated(zodiac::NodeHandle node);
+
+    ///
+    /// \brief Is emitted, when Node%s were removed, together with all of their Plug%s.
+    ///
+    /// \param [out] nodes  Handles of the removed Node%s, which are about to become invalid.
+    ///
+    void nodesRemoved(QList<zodiac::NodeHandle> nodes);
+
+    ///
+    /// \brief Is emitted, when a Node has changed its position in the Scene.
+    ///
+    /// \param [out] node   The moved Node.
+    ///
+    void nodeMoved(zodiac::NodeHandle node);
+
+    ///
+    /// \brief Is emitted with each change of the selection in the Scene.
+    ///
+    /// Only contains the Node%s whose selection has actually changed, the complete selection is available through
+    /// Scene::getSelectedNodes().
+    ///
+    /// \param [out] selected   Node%s that were added to the selection.
+    /// \param [out] deselected Node%s that were removed from the selection.
+    ///
+    void selectionChanged(QList<zodiac::NodeHandle> selected, QList<zodiac::NodeHandle> deselected);
+
+    ///
+    /// \brief Is emitted, when a Node was activated.
+    ///
+    /// \param [out] node   The activated Node.
+    ///
+    void nodeActivated(zodiac::NodeHandle node);
+
+    ///
+    /// \brief Is emitted, when a Node was renamed.
+    ///
+    /// \param [out] node   The renamed Node.
+    /// \param [out] name   New name of the Node.
+    ///
+    void nodeRenamed(zodiac::NodeHandle node, const QString& name);
+
+    ///
+    /// \brief Is emitted, when the user requested the removal of a Node.
+    ///
+    /// \param [out] node   Node to remove.
+    ///
+    void nodeRemovalRequested(zodiac::NodeHandle node);
+
+    ///
+    /// \brief Is emitted, when a Plug was created.
+    ///
+    /// \param [out] plug   The new Plug.
+    ///
+    void plugCreated(zodiac::PlugHandle plug);
+
+    ///
+    /// \brief Is emitted, when a single Plug was removed from its Node.
+    ///
+    /// \param [out] plug   The removed Plug, its handle is about to become invalid.
+    ///
+    void plugRemoved(zodiac::PlugHandle plug);
+
+    ///
+    /// \brief Is emitted, when a Plug was renamed.
+    ///
+    /// \param [out] plug   The renamed Plug.
+    /// \param [out] name   New name of the Plug.
+    ///
+    void plugRenamed(zodiac::PlugHandle plug, const QString& name);
+
+    ///
+    /// \brief Is emitted, when an outgoing Plug was connected to an incoming Plug of another Node.
+    ///
+    /// \param [out] output The outgoing Plug of the source Node.
+    /// \param [out] input  The incoming Plug of the target Node.
+    ///
+    void plugsConnected(zodiac::PlugHandle output, zodiac::PlugHandle input);
+
+    ///
+    /// \brief Is emitted, when the connection between an outgoing and an incoming Plug was removed.
+    ///
+    /// Connections removed together with one of their Node%s through Scene::removeNodes() are announced through
+    /// plugsDisconnectedInBulk() instead.
+    ///
+    /// \param [out] output The outgoing Plug of the source Node.
+    /// \param [out] input  The incoming Plug of the target Node.
+    ///
+    void plugsDisconnected(zodiac::PlugHandle output, zodiac::PlugHandle input);
+
+    ///
+    /// \brief Is emitted once by Scene::removeNodes() with all connections that were removed together with the Node%s.
+    ///
+    /// Each connection has at least one Plug on a removed Node, whose handle is about to become invalid.
+    /// As the removed Node%s are not part of the ChangeSet, neither are these connections.
+    ///
+    /// \param [out] connections    Removed connections as pairs of (output, input).
+    ///
+    void plugsDisconnectedInBulk(QList<QPair<zodiac::PlugHandle, zodiac::PlugHandle>> connections);
+
+    ///
+    /// \brief Is emitted once per pass of the event loop with all changes during the previous pass.
+    ///
+    /// Is only emitted if ChangeSet%s are enabled and something has changed.
+    ///
+    /// \param [out] changeSet  All changes since the last ChangeSet was emitted.
+    ///
+    void changeSetReady(zodiac::ChangeSet changeSet);
+
+private: // methods
+
+    ///
+    /// \brief Makes sure that the current ChangeSet is emitted with the next pass of the event loop.
+    ///
+    void scheduleChangeSet();
+
+private slots:
+
+    ///
+    /// \brief Records the creation of a Node.
+    ///
+    /// \param [in] node    The new Node.
+    ///
+    void recordNodeCreated(zodiac::NodeHandle node);
+
+    ///
+    /// \brief Records the removal of Node%s.
+    ///
+    /// \param [in] nodes   The removed Node%s.
+    ///
+    void recordNodesRemoved(QList<zodiac::NodeHandle> nodes);
+
+    ///
+    /// \brief Records the renaming of a Node.
+    ///
+    /// \param [in] node    The renamed Node.
+    ///
+    void recordNodeRenamed(zodiac::NodeHandle node);
+
+    ///
+    /// \brief Records the movement of a Node.
+    ///
+    /// \param [in] node    The moved Node.
+    ///
+    void recordNodeMoved(zodiac::NodeHandle node);
+
+    ///
+    /// \brief Records the creation of a Plug.
+    ///
+    /// \param [in] plug    The new Plug.
+    ///
+    void recordPlugCreated(zodiac::PlugHandle plug);
+
+    ///
+    /// \brief Records the removal of a Plug.
+    ///
+    /// \param [in] plug    The removed Plug.
+    ///
+    void recordPlugRemoved(zodiac::PlugHandle plug);
+
+    ///
+    /// \brief Records the renaming of a Plug.
+    ///
+    /// \param [in] plug    The renamed Plug.
+    ///
+    void recordPlugRenamed(zodiac::PlugHandle plug);
+
+    ///
+    /// \brief Records a new connection.
+    ///
+    /// \param [in] output  The outgoing Plug of the connection.
+    /// \param [in] input   The incoming Plug of the connection.
+    ///
+    void recordPlugsConnected(zodiac::PlugHandle output, zodiac::PlugHandle input);
+
+    ///
+    /// \brief Records a removed connection.
+    ///
+    /// \param [in] output  The outgoing Plug of the connection.
+    /// \param [in] input   The incoming Plug of the connection.
+    ///
+    void recordPlugsDisconnected(zodiac::PlugHandle output, zodiac::PlugHandle input);
+
+    ///
+    /// \brief Emits all changes recorded since the last call and starts a new ChangeSet.
+    ///
+    void emitChangeSet();
+
+private: // members
+
+    ///
+    /// \brief Whether changes are recorded and emitted as ChangeSet%s.
+    ///
+    bool m_areChangeSetsEnabled;
+
+    ///
+    /// \brief Whether the emission of the current ChangeSet is already scheduled.
+    ///
+    bool m_isChangeSetScheduled;
+
+    ///
+    /// \brief Changes recorded since the last ChangeSet was emitted.
+    ///
+    /// Connections are kept apart until the ChangeSet is emitted, see SignalHub::m_connections.
+    ///
+    ChangeSet m_changeSet;
+
+    ///
+    /// \brief New connections since the last ChangeSet was emitted, by their output and input Plug.
+    ///
+    /// Used to cancel out connections that are removed again during the same pass of the event loop.
+    ///
+    QHash<QPair<Plug*, Plug*>, QPair<PlugHandle, PlugHandle>> m_connections;
+
+    ///
+    /// \brief Removed connections since the last ChangeSet was emitted, by their output and input Plug.
+    ///
+    QHash<QPair<Plug*, Plug*>, QPair<PlugHandle, PlugHandle>> m_disconnections;
+};
+
+} // namespace zodiac
+
+Q_DECLARE_METATYPE(zodiac::ChangeSet)
+
+#endif // ZODIAC_SIGNALHUB_H
@@ -0,0 +1,201 @@
+#include "spriteatlas.h"
+
+#include <QPainter>
+#include <QPainterPath>
+#include <QPen>
+#include <QStyleOptionGraphicsItem>
+#include <QtMath>
+#include <QVector>
+
+#include <algorithm>
+#include <cmath>
+
+#include "utils.h"
+
+static int quantize(qreal value);
+
+namespace zodiac {
+
+int SpriteAtlas::s_maxSpriteSize = 256;
+
+SpriteAtlas::SpriteAtlas()
+    : m_isEnabled(false)
+    , m_sprites(QHash<SpriteKey, Sprite>())
+    , m_useCounter(0)
+{
+}
+
+void SpriteAtlas::setEnabled(bool enabled)
+{
+    m_isEnabled = enabled;
+    if(!m_isEnabled){
+        clear();
+    }
+}
+
+bool SpriteAtlas::drawDisk(QPainter* painter, qreal radius, const QColor& fill, const QPen& outline)
+{
+    int bucket;
+    qreal pixelRatio;
+    qreal scale;
+    if(!getBucket(painter, (radius*2.)+outline.widthF(), bucket, pixelRatio, scale)){
+        return false;
+    }
+
+    SpriteKey key = {0, bucket, quantize(pixelRatio), fill.rgba(), outline.color().rgba(),
+                     quantize(radius), quantize(outline.widthF()), 0};
+    const Sprite* sprite = useSprite(key);
+    if(sprite){
+        drawSprite(painter, *sprite);
+    } else {
+        QPainterPath path;
+        path.addEllipse(quadrat(radius));
+        drawSprite(painter, addSprite(key, path, outline, fill, scale, pixelRatio));
+    }
+    return true;
+}
+
+bool SpriteAtlas::drawSector(QPainter* painter, const QPointF& center, qreal innerRadius, qreal outerRadius,
+                             qreal midAngle, qreal arclength, const QColor& fill)
+{
+    int bucket;
+    qreal pixelRatio;
+    qreal scale;
+    if(!getBucket(painter, outerRadius*2., bucket, pixelRatio, scale)){
+        return false;
+    }
+
+    // the sprite is rendered around the positive x-axis and rotated into place
+    painter->save();
+    painter->translate(center);
+    painter->rotate(-qRadiansToDegrees(midAngle));
+
+    SpriteKey key = {1, bucket, quantize(pixelRatio), fill.rgba(), 0,
+                     quantize(innerRadius), quantize(outerRadius), quantize(arclength*64.)};
+    const Sprite* sprite = useSprite(key);
+    if(sprite){
+        drawSprite(painter, *sprite);
+    } else {
+        QPainterPath path;
+        path.addPolygon(annulusSector(QPointF(0., 0.), innerRadius, outerRadius, 0., arclength));
+        path.closeSubpath();
+        drawSprite(painter, addSprite(key, path, QPen(Qt::NoPen), fill, scale, pixelRatio));
+    }
+
+    painter->restore();
+    return true;
+}
+
+void SpriteAtlas::clear()
+{
+    m_sprites.clear();
+}
+
+bool SpriteAtlas::getBucket(QPainter* painter, qreal extent, int& bucket, qreal& pixelRatio, qreal& scale) const
+{
+    qreal levelOfDetail = QStyleOptionGraphicsItem::levelOfDetailFromTransform(painter->worldTransform());
+    if(levelOfDetail<=0.){
+        return false;
+    }
+
+    // round up, so sprites are rendered at least at the resolution at which they are drawn
+    bucket = qCeil(std::log2(levelOfDetail)*s_bucketsPerOctave);
+    scale = qPow(2., qreal(bucket)/s_bucketsPerOctave);
+
+    // on high-DPI screens, one pixel of the item's device is made up of several physical pixels
+    QPaintDevice* device = painter->device();
+    pixelRatio = device ? device->devicePixelRatioF() : 1.;
+    return extent*scale*pixelRatio <= s_maxSpriteSize;
+}
+
+const SpriteAtlas::Sprite* SpriteAtlas::useSprite(const SpriteKey& key)
+{
+    QHash<SpriteKey, Sprite>::iterator it = m_sprites.find(key);
+    if(it==m_sprites.end()){
+        return nullptr;
+    }
+    it.value().lastUse = ++m_useCounter;
+    return &it.value();
+}
+
+const SpriteAtlas::Sprite& SpriteAtlas::addSprite(const SpriteKey& key, const QPainterPath& path, const QPen& outline,
+                                                  const QColor& fill, qreal scale, qreal pixelRatio)
+{
+    if(m_sprites.size()>=s_maxSpriteCount){
+        evictSprites();
+    }
+
+    // cover the shape and its outline with whole physical pixels, plus one pixel for antialiasing
+    qreal pixelScale = scale*pixelRatio;
+    qreal overdraw = (outline.style()==Qt::NoPen ? 0. : outline.widthF()/2.) + (1./pixelScale);
+    QRectF rect = path.boundingRect().marginsAdded(QMarginsF(overdraw, overdraw, overdraw, overdraw));
+    QSize size(qCeil(rect.width()*pixelScale), qCeil(rect.height()*pixelScale));
+    rect.setSize(QSizeF(size)/pixelScale);
+
+    Sprite sprite;
+    sprite.rect = rect;
+    sprite.lastUse = ++m_useCounter;
+    sprite.pixmap = QPixmap(size);
+    sprite.pixmap.setDevicePixelRatio(pixelRatio);
+    sprite.pixmap.fill(Qt::transparent);
+    QPainter spritePainter(&sprite.pixmap);
+    spritePainter.setRenderHint(QPainter::Antialiasing);
+    spritePainter.scale(scale, scale);
+    spritePainter.translate(-rect.topLeft());
+    spritePainter.setPen(outline);
+    spritePainter.setBrush(fill);
+    spritePainter.drawPath(path);
+    spritePainter.end();
+
+    return m_sprites.insert(key, sprite).value();
+}
+
+void SpriteAtlas::evictSprites()
+{
+    // release the least recently drawn quarter of the atlas at once, so the sort is not repeated for every new sprite
+    QVector<quint64> uses;
+    uses.reserve(m_sprites.size());
+    for(const Sprite& sprite : m_sprites){
+        uses.append(sprite.lastUse);
+    }
+    QVector<quint64>::iterator threshold = uses.begin()+(uses.size()/4);
+    std::nth_element(uses.begin(), threshold, uses.end());
+    quint64 oldestKept = *threshold;
+
+    QHash<SpriteKey, Sprite>::iterator it = m_sprites.begin();
+    while(it!=m_sprites.end()){
+        if(it.value().lastUse<oldestKept){
+            it = m_sprites.erase(it);
+        } else {
+            ++it;
+        }
+    }
+}
+
+void SpriteAtlas::drawSprite(QPainter* painter, const Sprite& sprite) const
+{
+    // the sprite is scaled down by less than one bucket, which looks best when smoothed
+    bool wasSmooth = painter->testRenderHint(QPainter::SmoothPixmapTransform);
+    painter->setRenderHint(QPainter::SmoothPixmapTransform);
+    painter->drawPixmap(sprite.rect, sprite.pixmap, QRectF(sprite.pixmap.rect()));
+    painter->setRenderHint(QPainter::SmoothPixmapTransform, wasSmooth);
+}
+
+} // namespace zodiac
+
+///////////////////////////////////////////////////////////////////////////////////////////////////
+//
+// HELPER
+//
+
+///
+/// \brief Quantizes a measure of a shape, so that shapes which only differ by rounding errors share a sprite.
+///
+/// \param value    Measure to quantize.
+///
+/// \return         Measure in sixteenths.
+///
+static int quantize(qreal value)
+{
+    return qRound(value*16.);
+}
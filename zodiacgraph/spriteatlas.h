@@ -0,0 +1,279 @@
+//
+//    ZodiacGraph - A general-purpose, circular node graph UI module.
+//    Copyright (C) 2015  Clemens Sielaff
+//
+//    The MIT License
+//
+//    Permission is hereby granted, free of charge, to any person obtaining a copy of
+//    this software and associated documentation files (the "Software"), to deal in
+//    the Software without restriction, including without limitation the rights to
+//    use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+//    of the Software, and to permit persons to whom the Software is furnished to do so,
+//    subject to the following conditions:
+//
+//    The above copyright notice and this permission notice shall be included in all
+//    copies or substantial portions of the Software.
+//
+//    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//    SOFTWARE.
+//
+
+#ifndef ZODIAC_SPRITEATLAS_H
+#define ZODIAC_SPRITEATLAS_H
+
+///
+/// \file spriteatlas.h
+///
+/// \brief Contains the definition of the zodiac::SpriteAtlas class.
+///
+
+#include <QColor>
+#include <QHash>
+#include <QPixmap>
+#include <QRectF>
+
+class QPainter;
+class QPainterPath;
+class QPen;
+
+namespace zodiac {
+
+///
+/// \brief Shared, pre-rendered sprites of the shapes that are drawn by many items of a Scene in the same way.
+///
+/// Every collapsed Node paints the same outlined disk in one of two colors and many Plug%s share the same sector of an
+/// annulus.
+/// Caching each of these items in their own pixmap rasterizes and stores the same image over and over again.
+/// Instead, the SpriteAtlas renders each distinct shape once per zoom bucket and all items blit from the same pixmap.
+///
+/// The zoom buckets are spaced by a fraction of an octave, and the sprites are rendered at the upper end of their
+/// bucket, so that they are only ever scaled down slightly when drawn.
+/// Shapes that would be larger than the maximal sprite size on screen are not cached -- the caller has to draw them
+/// directly instead.
+///
+/// Sprites are rendered at the device pixel ratio of the painted device, so they stay sharp on high-DPI screens.
+/// Once the atlas is full, the least recently drawn sprites are released to make room for new ones.
+///
+/// The atlas is disabled by default.
+/// While it is enabled, the CachePolicy of the Scene does not cache Node%s and Plug%s in pixmaps of their own.
+class SpriteAtlas
+{
+
+public: // methods
+
+    ///
+    /// \brief Constructor.
+    ///
+    SpriteAtlas();
+
+    ///
+    /// \brief Whether items of the Scene draw their shapes from the atlas.
+    ///
+    /// \return <i>true</i> if the atlas is enabled -- <i>false</i> otherwise.
+    ///
+    inline bool isEnabled() const {return m_isEnabled;}
+
+    ///
+    /// \brief Enables or disables the atlas.
+    ///
+    /// Use Scene::setSpriteAtlasEnabled() instead, which also updates the CachePolicy of the Scene.
+    ///
+    /// \param [in] enabled <i>true</i> to enable the atlas -- <i>false</i> to disable it and release all sprites.
+    ///
+    void setEnabled(bool enabled);
+
+    ///
+    /// \brief Draws an outlined disk around the origin of the painter.
+    ///
+    /// \param [in] painter Painter to draw with.
+    /// \param [in] radius  Radius of the disk.
+    /// \param [in] fill    Fill color of the disk.
+    /// \param [in] outline Pen to draw the outline of the disk with.
+    ///
+    /// \return             <i>true</i> if the disk was drawn -- <i>false</i> if it is too large for a sprite.
+    ///
+    bool drawDisk(QPainter* painter, qreal radius, const QColor& fill, const QPen& outline);
+
+    ///
+    /// \brief Draws an unoutlined sector of an annulus.
+    ///
+    /// \param [in] painter     Painter to draw with.
+    /// \param [in] center      Center of the annulus.
+    /// \param [in] innerRadius Inner radius of the annulus.
+    /// \param [in] outerRadius Outer radius of the annulus.
+    /// \param [in] midAngle    Angle in radians at the middle of the sector, counter-clockwise from the x-axis.
+    /// \param [in] arclength   Angular size of the sector in radians.
+    /// \param [in] fill        Fill color of the sector.
+    ///
+    /// \return                 <i>true</i> if the sector was drawn -- <i>false</i> if it is too large for a sprite.
+    ///
+    bool drawSector(QPainter* painter, const QPointF& center, qreal innerRadius, qreal outerRadius,
+                    qreal midAngle, qreal arclength, const QColor& fill);
+
+    ///
+    /// \brief Releases all sprites.
+    ///
+    /// Is called by the Scene after a re-styling, as sprites of the old style are not going to be used again.
+    ///
+    void clear();
+
+    ///
+    /// \brief The number of sprites currently in the atlas.
+    ///
+    /// \return Number of sprites.
+    ///
+    inline int getSpriteCount() const {return m_sprites.size();}
+
+    ///
+    /// \brief The largest extent of a sprite on screen.
+    ///
+    /// \return Maximal sprite extent in pixels.
+    ///
+    static inline int getMaxSpriteSize() {return s_maxSpriteSize;}
+
+    ///
+    /// \brief Sets the largest extent of a sprite on screen.
+    ///
+    /// Larger shapes are drawn directly.
+    ///
+    /// \param [in] size    New maximal sprite extent in pixels.
+    ///
+    static inline void setMaxSpriteSize(int size) {s_maxSpriteSize=qMax(1, size);}
+
+private: // types
+
+    ///
+    /// \brief Identifies a sprite by its shape, style, zoom bucket and device pixel ratio.
+    ///
+    struct SpriteKey {
+        int shape;      ///< 0 for a disk, 1 for a sector.
+        int bucket;     ///< Zoom bucket.
+        int pixelRatio; ///< Quantized device pixel ratio.
+        QRgb fill;      ///< Fill color.
+        QRgb outline;   ///< Outline color.
+        int first;      ///< Quantized first measure of the shape (disk radius or inner radius).
+        int second;     ///< Quantized second measure of the shape (outline width or outer radius).
+        int third;      ///< Quantized third measure of the shape (unused or arclength).
+
+        inline bool operator==(const SpriteKey& other) const {
+            return (shape==other.shape) && (bucket==other.bucket) && (pixelRatio==other.pixelRatio)
+                    && (fill==other.fill) && (outline==other.outline)
+                    && (first==other.first) && (second==other.second) && (third==other.third);
+        }
+
+        friend inline uint qHash(const SpriteKey& key, uint seed = 0) {
+            uint hash = seed ^ uint(key.shape) ^ (uint(key.bucket) << 8) ^ (uint(key.pixelRatio) << 20);
+            hash = (hash*31) ^ key.fill;
+            hash = (hash*31) ^ key.outline;
+            hash = (hash*31) ^ uint(key.first);
+            hash = (hash*31) ^ uint(key.second);
+            hash = (hash*31) ^ uint(key.third);
+            return hash;
+        }
+    };
+
+    ///
+    /// \brief A pre-rendered shape.
+    ///
+    struct Sprite {
+        QPixmap pixmap;     ///< Rendered shape.
+        QRectF rect;        ///< Area covered by the pixmap in item coordinates.
+        quint64 lastUse;    ///< Value of the use counter of the atlas when the sprite was last drawn.
+    };
+
+private: // methods
+
+    ///
+    /// \brief Determines the zoom bucket of a painter.
+    ///
+    /// \param [in] painter     Painter to draw with.
+    /// \param [in] extent      Largest extent of the shape to draw in item coordinates.
+    /// \param [out] bucket     Zoom bucket of the painter.
+    /// \param [out] pixelRatio Device pixel ratio of the painted device.
+    /// \param [out] scale      Scale at which the sprites of the bucket are rendered, excluding the device pixel ratio.
+    ///
+    /// \return                 <i>false</i> if the shape would be too large for a sprite -- <i>true</i> otherwise.
+    ///
+    bool getBucket(QPainter* painter, qreal extent, int& bucket, qreal& pixelRatio, qreal& scale) const;
+
+    ///
+    /// \brief Looks up a sprite and marks it as used.
+    ///
+    /// \param [in] key     Key of the sprite.
+    ///
+    /// \return             The sprite or <i>nullptr</i>, if the atlas does not contain it.
+    ///
+    const Sprite* useSprite(const SpriteKey& key);
+
+    ///
+    /// \brief Renders a new sprite and adds it to the atlas.
+    ///
+    /// \param [in] key     Key of the new sprite.
+    /// \param [in] path    Shape to render in item coordinates.
+    /// \param [in] outline Pen to render the outline of the shape with.
+    /// \param [in] fill        Fill color of the shape.
+    /// \param [in] scale       Scale at which to render the shape.
+    /// \param [in] pixelRatio  Device pixel ratio at which to render the shape.
+    ///
+    /// \return                 The new sprite.
+    ///
+    const Sprite& addSprite(const SpriteKey& key, const QPainterPath& path, const QPen& outline,
+                            const QColor& fill, qreal scale, qreal pixelRatio);
+
+    ///
+    /// \brief Releases the least recently drawn sprites to make room for new ones.
+    ///
+    void evictSprites();
+
+    ///
+    /// \brief Draws a sprite with the given painter.
+    ///
+    /// \param [in] painter Painter to draw with.
+    /// \param [in] sprite  Sprite to draw.
+    ///
+    void drawSprite(QPainter* painter, const Sprite& sprite) const;
+
+private: // static members
+
+    ///
+    /// \brief Number of zoom buckets per octave.
+    ///
+    static const int s_bucketsPerOctave = 4;
+
+    ///
+    /// \brief Largest number of sprites in the atlas, before the least recently drawn ones are released.
+    ///
+    static const int s_maxSpriteCount = 512;
+
+    ///
+    /// \brief Largest extent of a sprite on screen in pixels.
+    ///
+    static int s_maxSpriteSize;
+
+private: // members
+
+    ///
+    /// \brief Whether items draw their shapes from the atlas.
+    ///
+    bool m_isEnabled;
+
+    ///
+    /// \brief All sprites in the atlas.
+    ///
+    QHash<SpriteKey, Sprite> m_sprites;
+
+    ///
+    /// \brief Increases with every sprite that is drawn, orders the sprites by their last use.
+    ///
+    quint64 m_useCounter;
+
+};
+
+} // namespace zodiac
+
+#endif // ZODIAC_SPRITEATLAS_H
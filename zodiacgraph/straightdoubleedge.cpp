@@ -3,7 +3,6 @@
 #include <QVector2D>
 
 #include "edgearrow.h"
-#include "edgegroupinterface.h"
 
 namespace zodiac {
 
@@ -19,16 +18,8 @@ StraightDoubleEdge::StraightDoubleEdge(Scene* scene, EdgeGroupInterface* group,
     updateShape();
 }
 
-void StraightDoubleEdge::updateLabel()
-{
-    setLabelText(m_group->getLabelText());
-    placeArrowAt(.5);
-}
-
 void StraightDoubleEdge::updateShape()
 {
-    prepareGeometryChange();
-
     // calculate the perpendicular edge offset
     QVector2D direction = QVector2D(m_endPoint-m_startPoint);
     direction.normalize();
@@ -43,6 +34,7 @@ void StraightDoubleEdge::updateShape()
     doubleLine.lineTo(m_endPoint-offset);
 
     m_path.swap(doubleLine);
+    updateBounds();
 
     // update the arrow
     placeArrowAt(.5);
@@ -62,11 +62,6 @@ public: // methods
     ///
     explicit StraightDoubleEdge(Scene* scene, EdgeGroupInterface* group, Node* fromNode, Node* toNode);
 
-    ///
-    /// \brief Generates and updates the text for the EdgeLabel of this edge.
-    ///
-    void updateLabel();
-
 protected: // methods
 
     ///
@@ -3,9 +3,12 @@
 #include <QGraphicsSceneMouseEvent>
 #include <QtMath>
 
+#include <cfloat>                       // for DBL_MAX
+
 #include "edgearrow.h"
 #include "edgegroupinterface.h"
 #include "node.h"
+#include "utils.h"
 #include "view.h"
 
 namespace zodiac {
@@ -30,9 +33,9 @@ StraightEdge::StraightEdge(Scene* scene, EdgeGroupInterface* group, Node* fromNo
 
 void StraightEdge::nodePositionHasChanged()
 {
-    // return early, if the shape has not changed
-    QPointF startPoint = m_fromNode->scenePos();
-    QPointF endPoint = m_toNode->scenePos();
+    // return early, if the shape has not changed (the edge might be moved as part of a DragLayer)
+    QPointF startPoint = mapFromScene(m_fromNode->scenePos());
+    QPointF endPoint = mapFromScene(m_toNode->scenePos());
     if((startPoint==m_startPoint)&&(endPoint==m_endPoint)){
         return;
     }
@@ -46,8 +49,17 @@ void StraightEdge::nodePositionHasChanged()
 
 void StraightEdge::updateLabel()
 {
-    setLabelText(m_group->getLabelText());
-    placeArrowAt(.5);
+    invalidateLabelText();
+}
+
+QString StraightEdge::getLabelText()
+{
+    return m_group->getLabelText(getLabelPage());
+}
+
+int StraightEdge::getLabelPageCount()
+{
+    return m_group->getLabelPageCount();
 }
 
 void StraightEdge::placeArrowAt(qreal fraction)
@@ -60,18 +72,30 @@ void StraightEdge::placeArrowAt(qreal fraction)
 
 void StraightEdge::updateShape()
 {
-    prepareGeometryChange();
-
     // update the path
     QPainterPath straightLine;
     straightLine.moveTo(m_startPoint);
     straightLine.lineTo(m_endPoint);
     m_path.swap(straightLine);
+    updateBounds();
 
     // update the arrow
     placeArrowAt(.5);
 }
 
+qreal StraightEdge::getDistanceTo(const QPointF& point) const
+{
+    // the path consists of one or more separate straight lines
+    qreal distance = DBL_MAX;
+    for(int i = 1; i < m_path.elementCount(); ++i){
+        const QPainterPath::Element& element = m_path.elementAt(i);
+        if(element.isLineTo()){
+            distance = qMin(distance, distanceToSegment(point, m_path.elementAt(i-1), element));
+        }
+    }
+    return distance;
+}
+
 void StraightEdge::mousePressEvent(QGraphicsSceneMouseEvent* event)
 {
     if(event->buttons() & View::getRemovalButton()){
@@ -92,3 +116,4 @@ void StraightEdge::mouseDoubleClickEvent(QGraphicsSceneMouseEvent *event)
 }
 
 } // namespace zodiac
+
@@ -69,10 +69,26 @@ public: // methods
     void nodePositionHasChanged();
 
     ///
-    /// \brief Generates and updates the text for this edge's EdgeLabel.
+    /// \brief Updates the text for this edge's EdgeLabel.
+    ///
+    /// The new text is only generated, when the label is shown next.
     ///
     void updateLabel();
 
+    ///
+    /// \brief Generates the text for this edge's EdgeLabel from the PlugEdge%s in its EdgeGroup or EdgeGroupPair.
+    ///
+    /// \return Text used for the EdgeLabel.
+    ///
+    virtual QString getLabelText();
+
+    ///
+    /// \brief The number of pages of the label text of the EdgeGroup or EdgeGroupPair.
+    ///
+    /// \return Number of pages of the label.
+    ///
+    virtual int getLabelPageCount();
+
     ///
     /// \brief The Node from which the PlugEdge%s in the EdgeGroup originate.
     ///
@@ -108,6 +124,17 @@ protected: // methods
     ///
     virtual void updateShape() override;
 
+    ///
+    /// \brief Calculates the distance of a point to the closest straight line of the edge.
+    ///
+    /// Works for the single line of a StraightEdge as well as for the two lines of a StraightDoubleEdge.
+    ///
+    /// \param [in] point  Point in local coordinates.
+    ///
+    /// \return            Distance of the point to the edge.
+    ///
+    virtual qreal getDistanceTo(const QPointF& point) const override;
+
     ///
     /// \brief Called, when the mouse is pressed as the cursor is on this item.
     ///
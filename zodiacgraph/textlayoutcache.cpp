@@ -0,0 +1,50 @@
+#include "textlayoutcache.h"
+
+#include <QFont>
+#include <QTextOption>
+#include <QTransform>
+#include <QtMath>
+
+namespace zodiac {
+
+TextLayoutCache::TextLayoutCache()
+    : m_texts(QHash<TextKey, QStaticText>())
+{
+}
+
+QStaticText TextLayoutCache::getText(const QString& text, const QFont& font, const QTextOption& option,
+                                     int rotationBucket)
+{
+    TextKey key = {text, font.key(),
+                   int(option.alignment()) | (int(option.wrapMode()) << 16) | (option.useDesignMetrics() << 24),
+                   rotationBucket};
+    QHash<TextKey, QStaticText>::const_iterator it = m_texts.constFind(key);
+    if(it!=m_texts.constEnd()){
+        return it.value();
+    }
+
+    // the cache only grows with the number of distinct texts, so simply start over if it gets too big
+    if(m_texts.size()>=s_maxTextCount){
+        m_texts.clear();
+    }
+
+    QStaticText staticText(text);
+    staticText.setTextFormat(Qt::PlainText);
+    staticText.setTextOption(option);
+    staticText.prepare(QTransform().rotate(rotationBucket), font);
+    m_texts.insert(key, staticText);
+    return staticText;
+}
+
+int TextLayoutCache::getRotationBucket(qreal radians)
+{
+    int degrees = qRound(qRadiansToDegrees(radians)) % 360;
+    return (degrees<0) ? degrees+360 : degrees;
+}
+
+void TextLayoutCache::clear()
+{
+    m_texts.clear();
+}
+
+} // namespace zodiac
@@ -0,0 +1,144 @@
+//
+//    ZodiacGraph - A general-purpose, circular node graph UI module.
+//    Copyright (C) 2015  Clemens Sielaff
+//
+//    The MIT License
+//
+//    Permission is hereby granted, free of charge, to any person obtaining a copy of
+//    this software and associated documentation files (the "Software"), to deal in
+//    the Software without restriction, including without limitation the rights to
+//    use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies
+//    of the Software, and to permit persons to whom the Software is furnished to do so,
+//    subject to the following conditions:
+//
+//    The above copyright notice and this permission notice shall be included in all
+//    copies or substantial portions of the Software.
+//
+//    THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+//    IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY,
+//    FITNESS FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE
+//    AUTHORS OR COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER
+//    LIABILITY, WHETHER IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM,
+//    OUT OF OR IN CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE
+//    SOFTWARE.
+//
+
+#ifndef ZODIAC_TEXTLAYOUTCACHE_H
+#define ZODIAC_TEXTLAYOUTCACHE_H
+
+///
+/// \file textlayoutcache.h
+///
+/// \brief Contains the definition of the zodiac::TextLayoutCache class.
+///
+
+#include <QHash>
+#include <QStaticText>
+#include <QString>
+
+class QFont;
+class QTextOption;
+
+namespace zodiac {
+
+///
+/// \brief Scene-wide cache of prepared text layouts, shared by all labels showing the same text.
+///
+/// Preparing a QStaticText shapes its text, which is expensive compared to drawing it.
+/// Plug names like "in", "out" or "value" repeat across thousands of Node%s, and every re-styling of the Scene used to
+/// shape each of them again.
+/// The TextLayoutCache prepares each distinct combination of text, font and text option only once and returns
+/// implicitly shared copies of the prepared QStaticText.
+///
+/// A QStaticText is laid out anew whenever it is drawn with a rotation other than the one it was prepared with.
+/// Rotated texts like the PlugLabel%s are therefore cached per rotation bucket and prepared with the rotation of their
+/// bucket, so the labels sharing a layout are all drawn with the same rotation.
+///
+class TextLayoutCache
+{
+
+public: // methods
+
+    ///
+    /// \brief Constructor.
+    ///
+    TextLayoutCache();
+
+    ///
+    /// \brief Returns the prepared layout of a text.
+    ///
+    /// \param [in] text            Plain text to lay out.
+    /// \param [in] font            Font of the text.
+    /// \param [in] option          Text option of the text.
+    /// \param [in] rotationBucket  Rotation of the text in degrees, see getRotationBucket().
+    ///
+    /// \return                     Shared, prepared static text.
+    ///
+    QStaticText getText(const QString& text, const QFont& font, const QTextOption& option, int rotationBucket = 0);
+
+    ///
+    /// \brief Releases all cached layouts.
+    ///
+    /// Is called by the Scene after a re-styling, as layouts in the old fonts are not going to be used again.
+    ///
+    void clear();
+
+    ///
+    /// \brief The number of distinct layouts currently in the cache.
+    ///
+    /// \return Number of cached layouts.
+    ///
+    inline int getTextCount() const {return m_texts.size();}
+
+public: // static methods
+
+    ///
+    /// \brief Quantizes a rotation to the buckets in which rotated texts are cached.
+    ///
+    /// Texts that are drawn rotated should be drawn with the rotation of their bucket, not with the exact one.
+    ///
+    /// \param [in] radians Rotation in radians.
+    ///
+    /// \return             Rotation bucket, the rotation in whole degrees [0 -> 360).
+    ///
+    static int getRotationBucket(qreal radians);
+
+private: // types
+
+    ///
+    /// \brief Identifies a layout by its text, font and text option.
+    ///
+    struct TextKey {
+        QString text;   ///< Plain text.
+        QString font;   ///< Key of the font, see QFont::key().
+        int option;     ///< Packed alignment, wrap mode and design metrics flag of the text option.
+        int rotation;   ///< Rotation bucket of the text.
+
+        inline bool operator==(const TextKey& other) const {
+            return (option==other.option) && (rotation==other.rotation) && (text==other.text) && (font==other.font);
+        }
+
+        friend inline uint qHash(const TextKey& key, uint seed = 0) {
+            return qHash(key.text, seed) ^ (qHash(key.font, seed)*31) ^ uint(key.option) ^ (uint(key.rotation) << 23);
+        }
+    };
+
+private: // static members
+
+    ///
+    /// \brief Largest number of layouts in the cache, before it is cleared.
+    ///
+    static const int s_maxTextCount = 4096;
+
+private: // members
+
+    ///
+    /// \brief All cached layouts.
+    ///
+    QHash<TextKey, QStaticText> m_texts;
+
+};
+
+} // namespace zodiac
+
+#endif // ZODIAC_TEXTLAYOUTCACHE_H
@@ -32,7 +32,10 @@
 /// \brief Common utils and enums that are used throughout the code.
 ///
 
+#include <QGraphicsItem>
+#include <QPolygonF>
 #include <QRectF>
+#include <QtMath>
 
 namespace zodiac {
 
@@ -47,10 +50,25 @@ enum zStack {
     NODE_CLOSED     = 0,    ///< A closed Node is the base line depth at zero.
     NODE_EXPANDED   = 10,   ///< An expanded Node automatically overlays a closed one.
     NODE_ACTIVE     = 20,   ///< The active Node (the last selected one) overlays other expanded Nodes.
+    DRAG_LAYER      = 25,   ///< Node%s that are dragged by the user overlay all others.
     EDGE_LABEL      = 30,   ///< EdgeLabel%s overlay all Node%s.
     DRAW_EDGE       = 40    ///< The DrawEdge is drawn in front of overthing.
 };
 
+///
+/// \brief Custom QGraphicsItem types of the cached items in the node view, returned by their type() method.
+///
+/// Allows the CachePolicy to identify items that are not QObject%s and to use qgraphicsitem_cast on them.
+///
+enum itemType {
+    NODE_TYPE       = QGraphicsItem::UserType + 1,  ///< Node.
+    PLUG_TYPE       = QGraphicsItem::UserType + 2,  ///< Plug.
+    PERIMETER_TYPE  = QGraphicsItem::UserType + 3,  ///< Perimeter.
+    NODE_LABEL_TYPE = QGraphicsItem::UserType + 4,  ///< NodeLabel.
+    PLUG_LABEL_TYPE = QGraphicsItem::UserType + 5,  ///< PlugLabel.
+    EDGE_LABEL_TYPE = QGraphicsItem::UserType + 6,  ///< EdgeLabel.
+};
+
 } // namespace zodiac
 
 ///
@@ -66,4 +84,71 @@ inline QRectF quadrat(qreal sidelength){
     return QRectF(-sidelength, -sidelength, sidelength*2, sidelength*2);
 }
 
+///
+/// \brief Calculates the distance of a point to a line segment.
+///
+/// \param point    Point to calculate the distance for.
+/// \param start    Start point of the segment.
+/// \param end      End point of the segment.
+///
+/// \return         Distance of the point to the segment.
+///
+inline qreal distanceToSegment(const QPointF& point, const QPointF& start, const QPointF& end){
+    QPointF segment = end-start;
+    QPointF delta = point-start;
+    qreal squaredLength = QPointF::dotProduct(segment, segment);
+
+    // project the point onto the segment, clamped to its end points
+    if(squaredLength>0.){
+        qreal t = qBound(0., QPointF::dotProduct(delta, segment)/squaredLength, 1.);
+        delta -= segment*t;
+    }
+    return qSqrt(QPointF::dotProduct(delta, delta));
+}
+
+///
+/// \brief Constructs the outline of an annulus sector as a polygon.
+///
+/// The arcs are divided into enough segments to appear round.
+///
+/// \param center       Center of the annulus.
+/// \param innerRadius  Inner radius of the annulus.
+/// \param outerRadius  Outer radius of the annulus.
+/// \param midAngle     Angle in radians at the middle of the sector, counter-clockwise from the positive x-axis.
+/// \param arclength    Angular size of the sector in radians.
+///
+/// \return             Closed outline of the sector, outer arc forward and inner arc backward.
+///
+inline QPolygonF annulusSector(const QPointF& center, qreal innerRadius, qreal outerRadius,
+                               qreal midAngle, qreal arclength){
+    static const qreal MAX_SEGMENT_ANGLE = qDegreesToRadians(3.);
+    int segmentCount = qBound(2, qCeil(arclength/MAX_SEGMENT_ANGLE), 64);
+    qreal startAngle = midAngle+(arclength/2.);
+    qreal segmentAngle = -arclength/segmentCount;
+
+    QPolygonF polygon(2*(segmentCount+1));
+    for(int i = 0; i <= segmentCount; ++i){
+        qreal angle = startAngle+(segmentAngle*i);
+        QPointF direction(qCos(angle), -qSin(angle));
+        polygon[i] = center+(direction*outerRadius);
+        polygon[(2*segmentCount)+1-i] = center+(direction*innerRadius);
+    }
+    return polygon;
+}
+
+///
+/// \brief Packs the coordinates of a grid cell into a single hash key.
+///
+/// Is used by the spatial indices of the Scene, which store their occupied cells in a hash map.
+/// The coordinates are packed as unsigned bits, as shifting a negative signed value is undefined behavior.
+///
+/// \param x        Horizontal cell coordinate.
+/// \param y        Vertical cell coordinate.
+///
+/// \return         Hash key of the cell.
+///
+inline qint64 gridCellKey(int x, int y){
+    return qint64((quint64(quint32(x)) << 32) | quint32(y));
+}
+
 #endif // ZODIAC_NODEUTILS_H
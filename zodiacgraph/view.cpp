@@ -7,14 +7,15 @@
 
 #include <QApplication>
 #include <QDebug>
+#include <QPainter>
+#include <QPaintEvent>
 #include <QPanGesture>
 #include <QPinchGesture>
+#include <QRubberBand>
 #include <QScrollBar>
 #include <QWheelEvent>
-#if PRINT_REDRAW_SPEED
-#include <QElapsedTimer>
-#endif
 
+#include "node.h"
 #include "scene.h"
 
 namespace zodiac {
@@ -27,21 +28,49 @@ Qt::MouseButton View::s_removalButton = Qt::MiddleButton;
 int View::s_activationKey = Qt::Key_Return;
 qreal View::s_minZoomFactor = 0.1;
 qreal View::s_maxZoomFactor = 2.0;
+bool View::s_isQualityGovernorEnabled = true;
+qreal View::s_frameBudget = 16.;
+int View::s_settleDelay = 200;
+int View::s_maxDirtyRectCount = 32;
+bool View::s_isSnapshotZoomEnabled = true;
+int View::s_zoomSettleDelay = 150;
 
 View::View(QWidget *parent)
     : QGraphicsView(parent)
     , m_zoomFactor(1.0)
+    , m_rubberBand(nullptr)
+    , m_rubberBandOrigin(QPoint())
+    , m_initialSelection(QSet<Node*>())
+    , m_rubberBandNodes(QSet<Node*>())
+    , m_isRubberBandActive(false)
+    , m_renderQuality(RenderQuality::FULL)
+    , m_isInteracting(false)
+    , m_frameClock(QElapsedTimer())
+    , m_lastFrameTime(0)
+    , m_rapidFrameCount(0)
+    , m_zoomSnapshot(QPixmap())
+    , m_snapshotTransform(QTransform())
+    , m_isSnapshotZooming(false)
 {
     setBackgroundBrush(QBrush(s_backgroundColor));
     setCacheMode(QGraphicsView::CacheBackground);
     setRenderHints(QPainter::Antialiasing);
     setViewportUpdateMode(QGraphicsView::MinimalViewportUpdate);
     setTransformationAnchor(QGraphicsView::AnchorUnderMouse);
-    setDragMode(QGraphicsView::RubberBandDrag);
+    setDragMode(QGraphicsView::NoDrag); // rubberband selection is handled by the view itself
 
     setAttribute(Qt::WA_AcceptTouchEvents);
     grabGesture(Qt::PanGesture);
     grabGesture(Qt::PinchGesture);
+
+    // restore full quality, once the interaction has stopped
+    m_settleTimer.setSingleShot(true);
+    connect(&m_settleTimer, SIGNAL(timeout()), this, SLOT(restoreQuality()));
+    m_frameClock.start();
+
+    // re-rasterize the scene, once the zoom has settled
+    m_zoomSettleTimer.setSingleShot(true);
+    connect(&m_zoomSettleTimer, SIGNAL(timeout()), this, SLOT(applySnapshotZoom()));
 }
 
 void View::updateStyle()
@@ -53,6 +82,12 @@ void View::updateStyle()
     resetCachedContent();
 }
 
+void View::beginInteraction()
+{
+    m_isInteracting = true;
+    m_settleTimer.start(s_settleDelay);
+}
+
 bool View::event(QEvent* event)
 {
     event->accept();
@@ -64,7 +99,7 @@ bool View::event(QEvent* event)
             return gestureEvent(static_cast<QGestureEvent*>(event));
 
         case QEvent::TouchEnd:
-            setDragMode(QGraphicsView::RubberBandDrag);
+            setDragMode(QGraphicsView::NoDrag);
             break;
 
         default:
@@ -74,7 +109,9 @@ bool View::event(QEvent* event)
 }
 
 bool View::gestureEvent(QGestureEvent* event)
-{   
+{
+    beginInteraction();
+
     //
     // pinch has precedence
     if (QGesture *pinchEvent = event->gesture(Qt::PinchGesture)) {
@@ -84,18 +121,7 @@ bool View::gestureEvent(QGestureEvent* event)
         // only pinch if the fingers have already moved a significant amount
         qreal totalScaleFactor = pinch->totalScaleFactor();
         if((totalScaleFactor < 0.66) || (totalScaleFactor > 1.5)){
-            qreal zoomDelta = pinch->scaleFactor();
-            qreal resultZoom = m_zoomFactor * zoomDelta;
-            if(resultZoom > s_maxZoomFactor){
-                zoomDelta = s_maxZoomFactor / m_zoomFactor;
-            }else if(resultZoom < s_minZoomFactor){
-                zoomDelta = s_minZoomFactor / m_zoomFactor;
-            }
-
-            // scale the view
-            scale(zoomDelta,zoomDelta);
-            m_zoomFactor *= zoomDelta;
-
+            zoomBy(pinch->scaleFactor(), viewport()->mapFromGlobal(pinch->centerPoint().toPoint()));
             return true;
         }
     }
@@ -103,6 +129,7 @@ bool View::gestureEvent(QGestureEvent* event)
     //
     // pan
     if (QGesture *panEvent = event->gesture(Qt::PanGesture)) {
+        applySnapshotZoom();
         QPanGesture* pan = static_cast<QPanGesture*>(panEvent);
         QPointF delta = pan->delta();
         qreal factor = (1.0 / m_zoomFactor) * 0.9;
@@ -128,6 +155,9 @@ bool View::viewportEvent(QEvent *event)
 
 void View::mousePressEvent(QMouseEvent* event)
 {
+    // items have to be hit where they are actually drawn
+    applySnapshotZoom();
+
     static const QTransform nullTransform = QTransform();
 
     if(event->button() == s_dragMoveButton){
@@ -139,15 +169,84 @@ void View::mousePressEvent(QMouseEvent* event)
         }
         return;
 
-    } else if (event->button() != s_selectionButton){
-        // do not allow rubberband selection with any button other than the selection button
-        setDragMode(QGraphicsView::NoDrag);
+    } else if ((event->button() == s_selectionButton) && (!itemAt(event->pos()))){
+        // let the scene see the click as well, it does not change the selection of any Node while Ctrl is held and
+        // the selection is replaced below otherwise
+        QGraphicsView::mousePressEvent(event);
+
+        // start a rubberband selection in empty space, holding Ctrl adds to the existing selection
+        m_initialSelection.clear();
+        if(event->modifiers() & Qt::ControlModifier){
+            m_initialSelection = static_cast<Scene*>(scene())->getSelectedNodes();
+        }
+        if(!m_rubberBand){
+            m_rubberBand = new QRubberBand(QRubberBand::Rectangle, viewport());
+        }
+        m_rubberBandOrigin = event->pos();
+        m_rubberBandNodes.clear();
+        m_isRubberBandActive = true;
+        static_cast<Scene*>(scene())->setNodeSelection(m_initialSelection);
+        event->accept();
+        return;
     }
     QGraphicsView::mousePressEvent(event);
 }
 
+void View::mouseMoveEvent(QMouseEvent* event)
+{
+    // dragging nodes, panning and rubberband selection are all interactions
+    if(event->buttons()!=Qt::NoButton){
+        applySnapshotZoom();
+        beginInteraction();
+    }
+
+    if(!m_isRubberBandActive){
+        QGraphicsView::mouseMoveEvent(event);
+        return;
+    }
+
+    QRect rubberBandRect = QRect(m_rubberBandOrigin, event->pos()).normalized();
+    m_rubberBand->setGeometry(rubberBandRect);
+    m_rubberBand->show();
+
+    // query the node index instead of testing the shape of every item inside the rubberband
+    Scene* zodiacScene = static_cast<Scene*>(scene());
+    QRectF sceneRect = mapToScene(rubberBandRect).boundingRect();
+    QSet<Node*> nodes;
+    for(Node* node : zodiacScene->getNodeIndex().getNodesInRect(sceneRect, Node::getCoreRadius())){
+        nodes.insert(node);
+    }
+
+    // only the nodes entering or leaving the rubberband change their selection, the initial selection is kept
+    QSet<Node*> addedNodes;
+    for(Node* node : nodes){
+        if((!m_rubberBandNodes.contains(node)) && (!m_initialSelection.contains(node))){
+            addedNodes.insert(node);
+        }
+    }
+    QSet<Node*> removedNodes;
+    for(Node* node : m_rubberBandNodes){
+        if((!nodes.contains(node)) && (!m_initialSelection.contains(node))){
+            removedNodes.insert(node);
+        }
+    }
+    m_rubberBandNodes.swap(nodes);
+    zodiacScene->changeNodeSelection(addedNodes, removedNodes);
+    event->accept();
+}
+
 void View::mouseReleaseEvent(QMouseEvent* event)
 {
+    if((m_isRubberBandActive) && (event->button() == s_selectionButton)){
+        m_rubberBand->hide();
+        m_isRubberBandActive = false;
+        m_initialSelection.clear();
+        m_rubberBandNodes.clear();
+        QGraphicsView::mouseReleaseEvent(event);
+        event->accept();
+        return;
+    }
+
     if (event->button() == s_dragMoveButton){
         // disable scroll dragging, if it was enabled
         if(dragMode()==QGraphicsView::ScrollHandDrag){
@@ -157,7 +256,7 @@ void View::mouseReleaseEvent(QMouseEvent* event)
     }
 
     // make sure to reset the drag mode
-    setDragMode(QGraphicsView::RubberBandDrag);
+    setDragMode(QGraphicsView::NoDrag);
 
     QGraphicsView::mouseReleaseEvent(event);
 }
@@ -175,36 +274,97 @@ void View::mouseDoubleClickEvent(QMouseEvent *event)
 
 void View::wheelEvent(QWheelEvent *event)
 {
-    // calculate the zoom factor and make sure it does not exceed its range
-    qreal zoomDelta = 1. + (event->angleDelta().y() * s_zoomSpeed);
+    beginInteraction();
+    zoomBy(1. + (event->angleDelta().y() * s_zoomSpeed), event->pos());
+
+    // do not call QGraphicsView::wheelEvent here, because it will scroll up or down as well as zoom
+    return;
+}
+
+void View::zoomBy(qreal zoomDelta, const QPoint& anchor)
+{
+    // make sure the zoom factor does not exceed its range
     qreal resultZoom = m_zoomFactor * zoomDelta;
     if(resultZoom > s_maxZoomFactor){
         zoomDelta = s_maxZoomFactor / m_zoomFactor;
     }else if(resultZoom < s_minZoomFactor){
         zoomDelta = s_minZoomFactor / m_zoomFactor;
     }
-
-    // scale the view
-    scale(zoomDelta,zoomDelta);
     m_zoomFactor *= zoomDelta;
 
-    // do not call QGraphicsView::wheelEvent here, because it will scroll up or down as well as zoom
-    return;
+    if(!s_isSnapshotZoomEnabled){
+        scale(zoomDelta,zoomDelta);
+        return;
+    }
+
+    // take a snapshot of the viewport at the start of a zoom gesture
+    if(!m_isSnapshotZooming){
+        m_zoomSnapshot = viewport()->grab();
+        m_snapshotTransform.reset();
+        m_isSnapshotZooming = true;
+    }
+
+    // scale the snapshot around the anchor, the actual view is only scaled once the zoom has settled
+    m_snapshotTransform *= QTransform::fromTranslate(-anchor.x(), -anchor.y())
+            * QTransform::fromScale(zoomDelta, zoomDelta)
+            * QTransform::fromTranslate(anchor.x(), anchor.y());
+    m_zoomSettleTimer.start(s_zoomSettleDelay);
+    viewport()->update();
+}
+
+void View::applySnapshotZoom()
+{
+    if(!m_isSnapshotZooming){
+        return;
+    }
+    m_isSnapshotZooming = false;
+    m_zoomSettleTimer.stop();
+    m_zoomSnapshot = QPixmap();
+
+    // the point in the center of the viewport has to end up where the snapshot transform has moved it to
+    QPoint center = viewport()->rect().center();
+    QPointF sceneCenter = mapToScene(center);
+    QPointF targetPos = m_snapshotTransform.map(QPointF(center));
+    qreal zoomDelta = m_snapshotTransform.m11();
+    m_snapshotTransform.reset();
+
+    ViewportAnchor anchor = transformationAnchor();
+    setTransformationAnchor(QGraphicsView::NoAnchor);
+    scale(zoomDelta, zoomDelta);
+    setTransformationAnchor(anchor);
+
+    QPointF offset = QPointF(mapFromScene(sceneCenter)) - targetPos;
+    QScrollBar* hScrollBar = horizontalScrollBar();
+    hScrollBar->setValue(hScrollBar->value() + qRound(offset.x()));
+    QScrollBar* vScrollBar = verticalScrollBar();
+    vScrollBar->setValue(vScrollBar->value() + qRound(offset.y()));
+
+    viewport()->update();
 }
 
 void View::paintEvent(QPaintEvent* event)
 {
+    // while zooming, only draw the scaled snapshot of the viewport
+    if(m_isSnapshotZooming){
+        QPainter painter(viewport());
+        painter.fillRect(event->rect(), s_backgroundColor);
+        painter.setRenderHint(QPainter::SmoothPixmapTransform, m_renderQuality==RenderQuality::FULL);
+        painter.setTransform(m_snapshotTransform);
+        painter.drawPixmap(0, 0, m_zoomSnapshot);
+        return;
+    }
+
 #if PRINT_REDRAW_SPEED
     static quint64 total=0;
     static quint64 divisor=1;
+#endif
     QElapsedTimer timer;
     timer.start();
-#endif
 
     QGraphicsView::paintEvent(event);
 
-#if PRINT_REDRAW_SPEED
     qint64 duration = timer.nsecsElapsed();
+#if PRINT_REDRAW_SPEED
     total+=duration;
     if(divisor%100==0){
         qDebug() << (total/divisor) * 0.000001 << "ms";
@@ -213,6 +373,92 @@ void View::paintEvent(QPaintEvent* event)
     }
     divisor++;
 #endif
+
+    // a series of frames in quick succession means that the scene is animated
+    qint64 frameTime = m_frameClock.elapsed();
+    if(frameTime-m_lastFrameTime < s_settleDelay){
+        if(++m_rapidFrameCount>=3){
+            beginInteraction();
+        }
+    } else {
+        m_rapidFrameCount = 0;
+    }
+    m_lastFrameTime = frameTime;
+
+    if((m_isInteracting) && (s_isQualityGovernorEnabled)){
+        adjustQuality(duration * 0.000001, event->region());
+    }
+
+    // count the drawn items for the cache statistics
+    Scene* zodiacScene = static_cast<Scene*>(scene());
+    if((zodiacScene) && (zodiacScene->getCachePolicy().areStatisticsEnabled())){
+        zodiacScene->getCachePolicy().recordFrame(mapToScene(event->rect()).boundingRect());
+    }
+}
+
+void View::adjustQuality(qreal frameTime, const QRegion& region)
+{
+    // coarsen the viewport update mode, if the dirty region consists of too many rects or covers most of the view
+    // the mode is only ever coarsened during an interaction, to avoid switching back and forth with every frame
+    QRect regionBounds = region.boundingRect();
+    qreal coverage = qreal(regionBounds.width()*regionBounds.height())
+            / qreal(qMax(1, viewport()->width()*viewport()->height()));
+    if((coverage>0.5) && (viewportUpdateMode()!=QGraphicsView::FullViewportUpdate)){
+        setViewportUpdateMode(QGraphicsView::FullViewportUpdate);
+    } else if((region.rectCount()>s_maxDirtyRectCount)
+              && (viewportUpdateMode()==QGraphicsView::MinimalViewportUpdate)){
+        setViewportUpdateMode(QGraphicsView::BoundingRectViewportUpdate);
+    }
+
+    // lower the rendering quality one step at a time, while the frames are over budget
+    if(frameTime<=s_frameBudget){
+        return;
+    }
+    if(m_renderQuality==RenderQuality::FULL){
+        setRenderQuality(RenderQuality::NO_ANTIALIASING);
+    } else if(m_renderQuality==RenderQuality::NO_ANTIALIASING){
+        setRenderQuality(RenderQuality::DRAFT);
+    }
+}
+
+void View::setRenderQuality(RenderQuality quality)
+{
+    if(quality==m_renderQuality){
+        return;
+    }
+    bool wereLabelsHidden = m_renderQuality==RenderQuality::DRAFT;
+    m_renderQuality = quality;
+
+    setRenderHint(QPainter::Antialiasing, quality==RenderQuality::FULL);
+
+    // labels are hidden by a flag of the scene, so this affects all views of the scene
+    bool areLabelsHidden = quality==RenderQuality::DRAFT;
+    Scene* zodiacScene = static_cast<Scene*>(scene());
+    if((zodiacScene) && (areLabelsHidden!=wereLabelsHidden)){
+        zodiacScene->setLabelsVisible(!areLabelsHidden);
+    }
+}
+
+void View::restoreQuality()
+{
+    m_isInteracting = false;
+    m_rapidFrameCount = 0;
+
+    // re-evaluate the item caches once the view has settled
+    Scene* zodiacScene = static_cast<Scene*>(scene());
+    if(zodiacScene){
+        zodiacScene->getCachePolicy().update(m_zoomFactor, mapToScene(viewport()->rect()).boundingRect());
+    }
+
+    if((m_renderQuality==RenderQuality::FULL)
+            && (viewportUpdateMode()==QGraphicsView::MinimalViewportUpdate)){
+        return;
+    }
+
+    // restore full quality with a single repaint
+    setRenderQuality(RenderQuality::FULL);
+    setViewportUpdateMode(QGraphicsView::MinimalViewportUpdate);
+    viewport()->update();
 }
 
 void View::setScene(Scene *scene)
@@ -220,4 +466,15 @@ void View::setScene(Scene *scene)
     QGraphicsView::setScene(scene);
 }
 
+void View::forgetNodes(const QList<Node*>& nodes)
+{
+    if(!m_isRubberBandActive){
+        return;
+    }
+    for(Node* node : nodes){
+        m_initialSelection.remove(node);
+        m_rubberBandNodes.remove(node);
+    }
+}
+
 } // namespace zodiac
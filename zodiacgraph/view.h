@@ -31,11 +31,18 @@
 /// \brief Contains the definition of the zodiac::View class.
 ///
 
+#include <QElapsedTimer>
 #include <QGraphicsView>
+#include <QPixmap>
+#include <QSet>
+#include <QTimer>
+#include <QTransform>
 
 class QEvent;
 class QGestureEvent;
 class QMouseEvent;
+class QRegion;
+class QRubberBand;
 class QWheelEvent;
 
 ///
@@ -46,8 +53,18 @@ class QWheelEvent;
 ///
 namespace zodiac {
 
+class Node;
 class Scene;
 
+///
+/// \brief Rendering quality of a View, which is lowered temporarily while the user interacts with a large graph.
+///
+enum class RenderQuality {
+    FULL,               ///< Antialiased rendering with all labels.
+    NO_ANTIALIASING,    ///< Antialiasing is disabled.
+    DRAFT,              ///< Antialiasing is disabled and all labels in the Scene are hidden.
+};
+
 ///
 /// \brief Widget that displays the contents of a Scene.
 ///
@@ -77,6 +94,15 @@ public: // methods
     ///
     void setScene(Scene *scene);
 
+    ///
+    /// \brief Removes Node%s from the current rubberband selection, before they are deleted.
+    ///
+    /// Is called by the Scene, whenever Node%s are removed from it.
+    ///
+    /// \param [in] nodes   Node%s that are removed from the Scene.
+    ///
+    void forgetNodes(const QList<Node*>& nodes);
+
     ///
     /// \brief Applies static styling changes of the View class to this instance.
     ///
@@ -85,6 +111,24 @@ public: // methods
     ///
     void updateStyle();
 
+    ///
+    /// \brief Notifies the View that the user is interacting with it.
+    ///
+    /// While interacting, the View lowers its RenderQuality and switches to coarser viewport update modes, whenever a
+    /// frame takes longer than the frame budget.
+    /// Once there has been no interaction for the settle delay, full quality is restored with a single repaint.
+    ///
+    /// Is called automatically when the View is zoomed or panned, Node%s are dragged or the Scene is animated.
+    ///
+    void beginInteraction();
+
+    ///
+    /// \brief The current rendering quality of this View.
+    ///
+    /// \return The current RenderQuality.
+    ///
+    inline RenderQuality getRenderQuality() const {return m_renderQuality;}
+
 public: // static methods
 
     ///
@@ -173,6 +217,80 @@ public: // static methods
     ///
     static inline void setActivationKey(int key) {s_activationKey=key;}
 
+    ///
+    /// \brief Whether View%s adapt their rendering quality to the measured frame time during interaction.
+    ///
+    /// \return <i>true</i> if the quality governor is enabled -- <i>false</i> otherwise.
+    ///
+    static inline bool isQualityGovernorEnabled() {return s_isQualityGovernorEnabled;}
+
+    ///
+    /// \brief Enables or disables the adaption of the rendering quality to the measured frame time.
+    ///
+    /// \param [in] enabled <i>true</i> to enable the quality governor -- <i>false</i> to always render full quality.
+    ///
+    static inline void setQualityGovernorEnabled(bool enabled) {s_isQualityGovernorEnabled=enabled;}
+
+    ///
+    /// \brief The time a single frame may take during interaction, before the rendering quality is lowered.
+    ///
+    /// \return Frame budget in milliseconds.
+    ///
+    static inline qreal getFrameBudget() {return s_frameBudget;}
+
+    ///
+    /// \brief Sets the time a single frame may take during interaction, before the rendering quality is lowered.
+    ///
+    /// \param [in] budget  Frame budget in milliseconds.
+    ///
+    static inline void setFrameBudget(qreal budget) {s_frameBudget=qMax(1., budget);}
+
+    ///
+    /// \brief The time without interaction, after which a View restores its full rendering quality.
+    ///
+    /// \return Settle delay in milliseconds.
+    ///
+    static inline int getSettleDelay() {return s_settleDelay;}
+
+    ///
+    /// \brief Sets the time without interaction, after which a View restores its full rendering quality.
+    ///
+    /// \param [in] delay   Settle delay in milliseconds.
+    ///
+    static inline void setSettleDelay(int delay) {s_settleDelay=qMax(1, delay);}
+
+    ///
+    /// \brief Whether View%s zoom by scaling a snapshot of their viewport, until the zoom has settled.
+    ///
+    /// \return <i>true</i> if snapshot zooming is enabled -- <i>false</i> otherwise.
+    ///
+    static inline bool isSnapshotZoomEnabled() {return s_isSnapshotZoomEnabled;}
+
+    ///
+    /// \brief Enables or disables zooming by scaling a snapshot of the viewport.
+    ///
+    /// Scaling the View invalidates the cached pixmaps of all items in the Scene.
+    /// With snapshot zooming enabled, a continuous zoom gesture only scales a snapshot of the viewport and the Scene is
+    /// re-rendered once, after the zoom has settled.
+    ///
+    /// \param [in] enabled <i>true</i> to enable snapshot zooming -- <i>false</i> to scale the View directly.
+    ///
+    static inline void setSnapshotZoomEnabled(bool enabled) {s_isSnapshotZoomEnabled=enabled;}
+
+    ///
+    /// \brief The time without zooming, after which the Scene is re-rendered at the new zoom factor.
+    ///
+    /// \return Zoom settle delay in milliseconds.
+    ///
+    static inline int getZoomSettleDelay() {return s_zoomSettleDelay;}
+
+    ///
+    /// \brief Sets the time without zooming, after which the Scene is re-rendered at the new zoom factor.
+    ///
+    /// \param [in] delay   Zoom settle delay in milliseconds.
+    ///
+    static inline void setZoomSettleDelay(int delay) {s_zoomSettleDelay=qMax(1, delay);}
+
 protected: // methods
 
     ///
@@ -211,6 +329,15 @@ protected: // methods
     ///
     void mousePressEvent(QMouseEvent* event);
 
+    ///
+    /// \brief Called, when the mouse is moved while the mouse cursor hovers on this widget.
+    ///
+    /// Updates the rubberband selection, if one is in progress.
+    ///
+    /// \param [in] event   Qt event object.
+    ///
+    void mouseMoveEvent(QMouseEvent* event);
+
     ///
     /// \brief Called after mousePressEvent, when the mouse button has been released.
     ///
@@ -239,6 +366,48 @@ protected: // methods
     ///
     void paintEvent(QPaintEvent* event);
 
+private: // methods
+
+    ///
+    /// \brief Zooms the View by a given factor, keeping the anchor position in place.
+    ///
+    /// If snapshot zooming is enabled, only the snapshot of the viewport is scaled until the zoom has settled.
+    ///
+    /// \param [in] zoomDelta   Factor to zoom by, the resulting zoom factor is clamped to the allowed range.
+    /// \param [in] anchor      Position in viewport coordinates that stays in place.
+    ///
+    void zoomBy(qreal zoomDelta, const QPoint& anchor);
+
+    ///
+    /// \brief Lowers the rendering quality and coarsens the viewport update mode, if a frame was over budget.
+    ///
+    /// \param [in] frameTime   Time it took to paint the last frame in milliseconds.
+    /// \param [in] region      Region painted in the last frame.
+    ///
+    void adjustQuality(qreal frameTime, const QRegion& region);
+
+    ///
+    /// \brief Applies a new rendering quality to this View.
+    ///
+    /// \param [in] quality     New RenderQuality.
+    ///
+    void setRenderQuality(RenderQuality quality);
+
+private slots:
+
+    ///
+    /// \brief Called after the settle delay has passed without interaction, restores the full rendering quality.
+    ///
+    void restoreQuality();
+
+    ///
+    /// \brief Applies the zoom of the scaled viewport snapshot to the View and re-renders the Scene.
+    ///
+    /// Is called once the zoom has settled or as soon as the user interacts with the View otherwise.
+    /// Does nothing, if the View is not zooming a snapshot.
+    ///
+    void applySnapshotZoom();
+
 private: // members
 
     ///
@@ -246,6 +415,86 @@ private: // members
     ///
     qreal m_zoomFactor;
 
+    ///
+    /// \brief Rubberband shown during a selection in empty space, is <i>nullptr</i> until the first selection.
+    ///
+    /// Node%s inside the rubberband are found through the NodeIndex of the Scene, instead of testing the shape of
+    /// every item in the rubberband.
+    ///
+    QRubberBand* m_rubberBand;
+
+    ///
+    /// \brief Position in view coordinates, where the rubberband selection started.
+    ///
+    QPoint m_rubberBandOrigin;
+
+    ///
+    /// \brief Node%s that were selected when an additive (Ctrl) rubberband selection started.
+    ///
+    QSet<Node*> m_initialSelection;
+
+    ///
+    /// \brief Node%s within the current rubberband, including those that were selected initially.
+    ///
+    QSet<Node*> m_rubberBandNodes;
+
+    ///
+    /// \brief Whether a rubberband selection is currently in progress.
+    ///
+    bool m_isRubberBandActive;
+
+    ///
+    /// \brief Current rendering quality of this View.
+    ///
+    RenderQuality m_renderQuality;
+
+    ///
+    /// \brief Whether the user is currently interacting with this View.
+    ///
+    bool m_isInteracting;
+
+    ///
+    /// \brief Fires after the settle delay has passed without interaction.
+    ///
+    QTimer m_settleTimer;
+
+    ///
+    /// \brief Running clock to measure the time between frames.
+    ///
+    QElapsedTimer m_frameClock;
+
+    ///
+    /// \brief Time on the frame clock, at which the last frame was finished.
+    ///
+    qint64 m_lastFrameTime;
+
+    ///
+    /// \brief Number of consecutive frames that followed each other within the settle delay.
+    ///
+    /// A series of frames in quick succession means that the Scene is animated.
+    ///
+    int m_rapidFrameCount;
+
+    ///
+    /// \brief Snapshot of the viewport taken at the start of a zoom gesture.
+    ///
+    QPixmap m_zoomSnapshot;
+
+    ///
+    /// \brief Accumulated transformation of the snapshot in viewport coordinates.
+    ///
+    QTransform m_snapshotTransform;
+
+    ///
+    /// \brief Whether the View is currently zooming a snapshot instead of the Scene.
+    ///
+    bool m_isSnapshotZooming;
+
+    ///
+    /// \brief Fires after the zoom settle delay has passed without zooming.
+    ///
+    QTimer m_zoomSettleTimer;
+
 private: // static members
 
     ///
@@ -288,6 +537,37 @@ private: // static members
     ///
     static qreal s_maxZoomFactor;
 
+    ///
+    /// \brief Whether View%s adapt their rendering quality to the measured frame time during interaction.
+    ///
+    static bool s_isQualityGovernorEnabled;
+
+    ///
+    /// \brief Time a single frame may take during interaction in milliseconds.
+    ///
+    static qreal s_frameBudget;
+
+    ///
+    /// \brief Time without interaction in milliseconds, after which full rendering quality is restored.
+    ///
+    static int s_settleDelay;
+
+    ///
+    /// \brief Number of separate dirty rectangles in a frame, above which the bounding rect of the dirty region is
+    /// repainted instead.
+    ///
+    static int s_maxDirtyRectCount;
+
+    ///
+    /// \brief Whether View%s zoom by scaling a snapshot of their viewport, until the zoom has settled.
+    ///
+    static bool s_isSnapshotZoomEnabled;
+
+    ///
+    /// \brief Time without zooming in milliseconds, after which the Scene is re-rendered at the new zoom factor.
+    ///
+    static int s_zoomSettleDelay;
+
 };
 
 } // namespace zodiac